@@ -0,0 +1,48 @@
+# Runs the integration tests with an instrumented autopilot and turns the profile into one for the game executable.
+# Called by the pgo_train target with PGO_COMPILER, PGO_CTEST, PGO_PROFILE_DIR, PGO_SOURCE_DIR and PGO_TARGET set.
+
+# A test that fails the save comparison still exercises the simulation, so the result is only reported
+execute_process(COMMAND ${PGO_CTEST} -R "^sav_" RESULT_VARIABLE RESULT)
+if(NOT RESULT EQUAL 0)
+    message(WARNING "Some integration tests failed their save comparison, their runs are still part of the profile")
+endif()
+
+if(PGO_COMPILER STREQUAL "GNU")
+    # GCC names the profile files after the object files: rename them to the objects of the game executable
+    set(AUTOPILOT_PREFIX "test#CMakeFiles#autopilot.dir#")
+    string(REPLACE "/" "#" SOURCE_PREFIX "${PGO_SOURCE_DIR}/")
+    string(REGEX REPLACE "^#" "" SOURCE_PREFIX "${SOURCE_PREFIX}")
+    file(GLOB PROFILES RELATIVE ${PGO_PROFILE_DIR} "${PGO_PROFILE_DIR}/${AUTOPILOT_PREFIX}*.gcda")
+    foreach(PROFILE ${PROFILES})
+        string(LENGTH "${AUTOPILOT_PREFIX}" PREFIX_LENGTH)
+        string(SUBSTRING "${PROFILE}" ${PREFIX_LENGTH} -1 OBJECT)
+        string(FIND "${OBJECT}" "__#" PARENT_POSITION)
+        string(FIND "${OBJECT}" "${SOURCE_PREFIX}" SOURCE_POSITION)
+        if(PARENT_POSITION EQUAL 0)
+            string(SUBSTRING "${OBJECT}" 3 -1 OBJECT)
+        elseif(SOURCE_POSITION EQUAL 0)
+            string(LENGTH "${SOURCE_PREFIX}" PREFIX_LENGTH)
+            string(SUBSTRING "${OBJECT}" ${PREFIX_LENGTH} -1 OBJECT)
+        else()
+            # not a source of the game
+            set(OBJECT "")
+        endif()
+        if(OBJECT)
+            file(RENAME "${PGO_PROFILE_DIR}/${PROFILE}" "${PGO_PROFILE_DIR}/CMakeFiles#${PGO_TARGET}.dir#${OBJECT}")
+        endif()
+    endforeach()
+elseif(PGO_COMPILER MATCHES "Clang")
+    # Clang profiles refer to functions instead of files: merge them into one
+    find_program(LLVM_PROFDATA NAMES llvm-profdata)
+    if(NOT LLVM_PROFDATA)
+        message(FATAL_ERROR "llvm-profdata is needed to merge the profile of the training run")
+    endif()
+    file(GLOB PROFILES "${PGO_PROFILE_DIR}/*.profraw")
+    execute_process(
+        COMMAND ${LLVM_PROFDATA} merge -output=${PGO_PROFILE_DIR}/${PGO_TARGET}.profdata ${PROFILES}
+        RESULT_VARIABLE RESULT
+    )
+    if(NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "Unable to merge the profile of the training run")
+    endif()
+endif()
@@ -15,6 +15,7 @@
 #include "city/population.h"
 #include "city/warning.h"
 #include "core/array.h"
+#include "core/calc.h"
 #include "core/log.h"
 #include "figure/formation_legion.h"
 #include "game/difficulty.h"
@@ -29,12 +30,26 @@
 #include "map/terrain.h"
 #include "map/tiles.h"
 
+#include <stdlib.h>
+
 #define BUILDING_ARRAY_SIZE_STEP 2000
 
+// Buildings of every type are also kept per square area of the map, to quickly find the closest one
+#define AREA_CELL_SIZE 16
+#define AREA_CELLS_PER_ROW ((GRID_SIZE + AREA_CELL_SIZE - 1) / AREA_CELL_SIZE)
+#define AREA_CELLS (AREA_CELLS_PER_ROW * AREA_CELLS_PER_ROW)
+
+typedef struct {
+    int *ids;
+    int size;
+    int capacity;
+} area_cell;
+
 static struct {
     array(building) buildings;
     building *first_of_type[BUILDING_TYPE_MAX];
     building *last_of_type[BUILDING_TYPE_MAX];
+    area_cell *areas[BUILDING_TYPE_MAX];
 } data;
 
 static struct {
@@ -100,8 +115,84 @@ building *building_next(building *b)
     return array_item(data.buildings, b->next_part_building_id);
 }
 
+static int area_cell_coordinate(int coordinate)
+{
+    return calc_bound(coordinate / AREA_CELL_SIZE, 0, AREA_CELLS_PER_ROW - 1);
+}
+
+static int area_cell_index(int x, int y)
+{
+    return area_cell_coordinate(y) * AREA_CELLS_PER_ROW + area_cell_coordinate(x);
+}
+
+static void add_to_area(const building *b)
+{
+    if (!data.areas[b->type]) {
+        data.areas[b->type] = calloc(AREA_CELLS, sizeof(area_cell));
+        if (!data.areas[b->type]) {
+            log_error("Unable to allocate memory for the building area index", 0, b->type);
+            return;
+        }
+    }
+    area_cell *cell = &data.areas[b->type][area_cell_index(b->x, b->y)];
+    for (int i = 0; i < cell->size; i++) {
+        if (cell->ids[i] == b->id) {
+            return;
+        }
+    }
+    if (cell->size == cell->capacity) {
+        int capacity = cell->capacity ? cell->capacity * 2 : 8;
+        int *ids = realloc(cell->ids, capacity * sizeof(int));
+        if (!ids) {
+            log_error("Unable to allocate memory for the building area index", 0, b->type);
+            return;
+        }
+        cell->ids = ids;
+        cell->capacity = capacity;
+    }
+    cell->ids[cell->size++] = b->id;
+}
+
+static int remove_from_area_cell(area_cell *cell, int building_id)
+{
+    for (int i = 0; i < cell->size; i++) {
+        if (cell->ids[i] == building_id) {
+            cell->ids[i] = cell->ids[--cell->size];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void remove_from_area(const building *b)
+{
+    area_cell *cells = data.areas[b->type];
+    if (!cells || remove_from_area_cell(&cells[area_cell_index(b->x, b->y)], b->id)) {
+        return;
+    }
+    // The building was moved without building_set_position: look for it everywhere
+    for (int i = 0; i < AREA_CELLS; i++) {
+        if (remove_from_area_cell(&cells[i], b->id)) {
+            log_error("Building moved without updating the area index", 0, b->id);
+            return;
+        }
+    }
+}
+
+static void clear_areas(void)
+{
+    for (int type = 0; type < BUILDING_TYPE_MAX; type++) {
+        if (data.areas[type]) {
+            for (int i = 0; i < AREA_CELLS; i++) {
+                data.areas[type][i].size = 0;
+            }
+        }
+    }
+}
+
 static void fill_adjacent_types(building *b)
 {
+    add_to_area(b);
     building *first = data.first_of_type[b->type];
     building *last = data.last_of_type[b->type];
     if (!first || !last) {
@@ -138,6 +229,7 @@ static void fill_adjacent_types(building *b)
 
 static void remove_adjacent_types(building *b)
 {
+    remove_from_area(b);
     building *first = data.first_of_type[b->type];
     building *last = data.last_of_type[b->type];
     if (b == first && b == last) {
@@ -183,8 +275,6 @@ building *building_create(building_type type, int x, int y)
     b->sentiment.house_happiness = 100;
     b->distance_from_entry = 0;
 
-    fill_adjacent_types(b);
-
     // house size
     b->house_size = 0;
     if (type >= BUILDING_HOUSE_SMALL_TENT && type <= BUILDING_HOUSE_MEDIUM_INSULA) {
@@ -288,6 +378,8 @@ building *building_create(building_type type, int x, int y)
     b->fire_proof = props->fire_proof;
     b->is_adjacent_to_water = map_terrain_is_adjacent_to_water(x, y, b->size);
 
+    fill_adjacent_types(b);
+
     // init expanded data
     b->house_tavern_wine_access = 0;
     b->house_tavern_meat_access = 0;
@@ -317,6 +409,59 @@ void building_change_type(building *b, building_type type)
     fill_adjacent_types(b);
 }
 
+void building_set_position(building *b, int x, int y)
+{
+    remove_from_area(b);
+    b->x = x;
+    b->y = y;
+    b->grid_offset = map_grid_offset(x, y);
+    add_to_area(b);
+}
+
+building *building_find_closest_of_type(building_type type, int x, int y, int max_distance)
+{
+    area_cell *cells = data.areas[type];
+    if (!cells) {
+        return 0;
+    }
+    building *closest = 0;
+    int closest_distance = max_distance;
+    int cell_x = area_cell_coordinate(x);
+    int cell_y = area_cell_coordinate(y);
+    // Walk rings of cells around the tile until no building in the next ring can be as close as the closest one
+    for (int ring = 0; ring < AREA_CELLS_PER_ROW; ring++) {
+        int ring_distance = ring ? (ring - 1) * AREA_CELL_SIZE + 1 : 0;
+        if (ring_distance >= max_distance || (closest && ring_distance > closest_distance)) {
+            break;
+        }
+        for (int yy = cell_y - ring; yy <= cell_y + ring; yy++) {
+            if (yy < 0 || yy >= AREA_CELLS_PER_ROW) {
+                continue;
+            }
+            int step = yy == cell_y - ring || yy == cell_y + ring ? 1 : 2 * ring;
+            for (int xx = cell_x - ring; xx <= cell_x + ring; xx += step) {
+                if (xx < 0 || xx >= AREA_CELLS_PER_ROW) {
+                    continue;
+                }
+                const area_cell *cell = &cells[yy * AREA_CELLS_PER_ROW + xx];
+                for (int i = 0; i < cell->size; i++) {
+                    building *b = array_item(data.buildings, cell->ids[i]);
+                    if (b->type != type || b->state != BUILDING_STATE_IN_USE) {
+                        continue;
+                    }
+                    int distance = calc_maximum_distance(x, y, b->x, b->y);
+                    if (distance < closest_distance ||
+                        (closest && distance == closest_distance && b->id < closest->id)) {
+                        closest = b;
+                        closest_distance = distance;
+                    }
+                }
+            }
+        }
+    }
+    return closest;
+}
+
 static void building_delete(building *b)
 {
     building_clear_related_data(b);
@@ -325,6 +470,7 @@ static void building_delete(building *b)
     memset(b, 0, sizeof(building));
     b->id = id;
 
+    array_item_released(data.buildings, id);
     array_trim(data.buildings);
 }
 
@@ -364,6 +510,13 @@ void building_clear_related_data(building *b)
     }
 }
 
+void building_release_from_undo(int building_id)
+{
+    if (building_id > 0 && building_id < data.buildings.size) {
+        array_item_released(data.buildings, building_id);
+    }
+}
+
 building *building_restore_from_undo(building *to_restore)
 {
     building *b = array_item(data.buildings, to_restore->id);
@@ -637,11 +790,13 @@ void building_clear_all(void)
 {
     memset(data.first_of_type, 0, sizeof(data.first_of_type));
     memset(data.last_of_type, 0, sizeof(data.last_of_type));
+    clear_areas();
 
     if (!array_init(data.buildings, BUILDING_ARRAY_SIZE_STEP, initialize_new_building, building_in_use) ||
         !array_next(data.buildings)) { // Ignore first building
         log_error("Unable to allocate enough memory for the building array. The game will now crash.", 0, 0);
     }
+    array_track_used_items(data.buildings);
 
     extra.created_sequence = 0;
     extra.incorrect_houses = 0;
@@ -652,7 +807,7 @@ void building_save_state(buffer *buf, buffer *highest_id, buffer *highest_id_eve
     buffer *sequence, buffer *corrupt_houses)
 {
     int buf_size = 4 + data.buildings.size * BUILDING_STATE_CURRENT_BUFFER_SIZE;
-    uint8_t *buf_data = malloc(buf_size);
+    uint8_t *buf_data = calloc(1, buf_size);
     buffer_init(buf, buf_data, buf_size);
     buffer_write_i32(buf, BUILDING_STATE_CURRENT_BUFFER_SIZE);
     building *b;
@@ -685,9 +840,11 @@ void building_load_state(buffer *buf, buffer *sequence, buffer *corrupt_houses,
         !array_expand(data.buildings, buildings_to_load)) {
         log_error("Unable to allocate enought memory for the building array. The game will now crash.", 0, 0);
     }
+    array_track_used_items(data.buildings);
 
     memset(data.first_of_type, 0, sizeof(data.first_of_type));
     memset(data.last_of_type, 0, sizeof(data.last_of_type));
+    clear_areas();
 
     int highest_id_in_use = 0;
 
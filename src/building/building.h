@@ -201,6 +201,18 @@ building *building_first_of_type(building_type type);
 
 void building_change_type(building *b, building_type type);
 
+void building_set_position(building *b, int x, int y);
+
+/**
+ * Finds the building of the given type in use that is closest to a tile
+ * @param type Building type
+ * @param x X tile to measure from
+ * @param y Y tile to measure from
+ * @param max_distance Buildings at this distance or further away are ignored
+ * @return The closest building, the one with the lowest id if several are equally close, or 0 if there is none
+ */
+building *building_find_closest_of_type(building_type type, int x, int y, int max_distance);
+
 building *building_main(building *b);
 
 building *building_next(building *b);
@@ -211,6 +223,12 @@ void building_clear_related_data(building *b);
 
 building *building_restore_from_undo(building *to_restore);
 
+/**
+ * Reports that a building is no longer kept for undo, so that its id can be reused if it is not in use
+ * @param building_id The id of the building
+ */
+void building_release_from_undo(int building_id);
+
 void building_trim(void);
 
 void building_update_state(void);
@@ -24,6 +24,7 @@
 #include "core/config.h"
 #include "core/image.h"
 #include "figure/formation.h"
+#include "game/replay.h"
 #include "game/undo.h"
 #include "graphics/window.h"
 #include "map/aqueduct.h"
@@ -31,6 +32,7 @@
 #include "map/building.h"
 #include "map/building_tiles.h"
 #include "map/grid.h"
+#include "map/journal.h"
 #include "map/image.h"
 #include "map/point.h"
 #include "map/property.h"
@@ -293,8 +295,8 @@ static int plot_draggable_building(int x_start, int y_start, int x_end, int y_en
 {
     int x_min, y_min, x_max, y_max;
     map_grid_start_end_to_area(x_start, y_start, x_end, y_end, &x_min, &y_min, &x_max, &y_max);
-    map_image_restore();
-    map_image_backup();
+    map_journal_restore(MAP_JOURNAL_IMAGE);
+    map_journal_backup(MAP_JOURNAL_IMAGE);
 
     int terrain = TERRAIN_NOT_CLEAR;
     if (allow_roads) {
@@ -319,7 +321,7 @@ static int place_draggable_building(int x_start, int y_start, int x_end, int y_e
 {
     int x_min, y_min, x_max, y_max;
     map_grid_start_end_to_area(x_start, y_start, x_end, y_end, &x_min, &y_min, &x_max, &y_max);
-    map_image_restore();
+    map_journal_restore(MAP_JOURNAL_IMAGE);
 
     int items_placed = 0;
     int gates_placed = 0;
@@ -581,6 +583,7 @@ void building_construction_start(int x, int y, int grid_offset)
     data.start.x = data.end.x = x;
     data.start.y = data.end.y = y;
 
+    map_routing_clear_building_distances();
     if (game_undo_start_build(data.type)) {
         data.in_progress = 1;
         int can_start = 1;
@@ -651,6 +654,7 @@ int building_construction_is_updatable(void)
 void building_construction_cancel(void)
 {
     map_property_clear_constructing_and_deleted();
+    map_routing_clear_building_distances();
     if (data.in_progress && building_construction_is_updatable()) {
         if (building_construction_is_updatable()) {
             game_undo_restore_map(1);
@@ -863,8 +867,11 @@ static figure_type nearby_enemy_type(int x_start, int y_start, int x_end, int y_
 
 void building_construction_place(void)
 {
+    game_replay_record_construction(data.type, data.sub_type, data.start.x, data.start.y, data.end.x, data.end.y);
     data.cost_preview = 0;
     data.in_progress = 0;
+    // the final placement always routes on the current map
+    map_routing_clear_building_distances();
     int x_start = data.start.x;
     int y_start = data.start.y;
     int x_end = data.end.x;
@@ -1012,6 +1019,19 @@ void building_construction_place(void)
     game_undo_finish_build(placement_cost);
 }
 
+void building_construction_replay(building_type type, building_type sub_type,
+    int x_start, int y_start, int x_end, int y_end)
+{
+    building_construction_set_type(type);
+    data.sub_type = sub_type;
+    building_construction_start(x_start, y_start, map_grid_offset(x_start, y_start));
+    if (!data.in_progress) {
+        return;
+    }
+    building_construction_update(x_end, y_end, map_grid_offset(x_end, y_end));
+    building_construction_place();
+}
+
 static void set_warning(int *warning_id, int warning)
 {
     if (warning_id) {
@@ -37,6 +37,12 @@ void building_construction_update(int x, int y, int grid_offset);
 
 void building_construction_place(void);
 
+/**
+ * Places a building the same way as dragging it from start to end with the mouse, used to replay recorded games
+ */
+void building_construction_replay(building_type type, building_type sub_type,
+    int x_start, int y_start, int x_end, int y_end);
+
 int building_construction_can_place_on_terrain(int x, int y, int *warning_id);
 
 void building_construction_record_view_position(int view_x, int view_y, int grid_offset);
@@ -120,9 +120,7 @@ static void add_warehouse(building *b)
     }
     b = building_get(id);
     // adjust BUILDING_WAREHOUSE
-    b->x = b->x + x_offset[corner];
-    b->y = b->y + y_offset[corner];
-    b->grid_offset = map_grid_offset(b->x, b->y);
+    building_set_position(b, b->x + x_offset[corner], b->y + y_offset[corner]);
     game_undo_adjust_building(b);
 
     building_get(prev)->next_part_building_id = 0;
@@ -120,7 +120,8 @@ int building_construction_place_wall(int measure_only, int x_start, int y_start,
         return 0;
     }
     int items_placed = 0;
-    if (place_routed_building(x_start, y_start, x_end, y_end, ROUTED_BUILDING_WALL, &items_placed)) {
+    if (map_routing_calculate_distances_for_building(ROUTED_BUILDING_WALL, x_start, y_start) &&
+            place_routed_building(x_start, y_start, x_end, y_end, ROUTED_BUILDING_WALL, &items_placed)) {
         if (!measure_only) {
             map_routing_update_land();
             map_routing_update_walls();
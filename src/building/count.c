@@ -4,6 +4,7 @@
 #include "building/monument.h"
 #include "city/buildings.h"
 #include "city/health.h"
+#include "core/log.h"
 #include "figure/figure.h"
 
 #include <stdlib.h>
@@ -80,183 +81,290 @@ static void limit_hippodrome(void)
     }
 }
 
-void building_count_update(void)
+// All building types that building_count_update looks at, in no particular order
+static const building_type COUNTED_TYPES[] = {
+    BUILDING_THEATER, BUILDING_AMPHITHEATER, BUILDING_COLOSSEUM, BUILDING_HIPPODROME, BUILDING_ARENA,
+    BUILDING_BARRACKS, BUILDING_HOSPITAL, BUILDING_RESERVOIR, BUILDING_FOUNTAIN,
+    BUILDING_SCHOOL, BUILDING_LIBRARY, BUILDING_ACADEMY, BUILDING_MISSION_POST,
+    BUILDING_BARBER, BUILDING_BATHHOUSE, BUILDING_DOCTOR,
+    BUILDING_FORUM, BUILDING_FORUM_UPGRADED, BUILDING_SENATE, BUILDING_SENATE_UPGRADED,
+    BUILDING_ACTOR_COLONY, BUILDING_GLADIATOR_SCHOOL, BUILDING_LION_HOUSE, BUILDING_CHARIOT_MAKER,
+    BUILDING_MARKET, BUILDING_TAVERN, BUILDING_CARAVANSERAI, BUILDING_MILITARY_ACADEMY, BUILDING_MESS_HALL,
+    BUILDING_SMALL_TEMPLE_CERES, BUILDING_SMALL_TEMPLE_NEPTUNE, BUILDING_SMALL_TEMPLE_MERCURY,
+    BUILDING_SMALL_TEMPLE_MARS, BUILDING_SMALL_TEMPLE_VENUS,
+    BUILDING_LARGE_TEMPLE_CERES, BUILDING_LARGE_TEMPLE_NEPTUNE, BUILDING_LARGE_TEMPLE_MERCURY,
+    BUILDING_LARGE_TEMPLE_MARS, BUILDING_LARGE_TEMPLE_VENUS,
+    BUILDING_GRAND_TEMPLE_CERES, BUILDING_GRAND_TEMPLE_NEPTUNE, BUILDING_GRAND_TEMPLE_MERCURY,
+    BUILDING_GRAND_TEMPLE_MARS, BUILDING_GRAND_TEMPLE_VENUS, BUILDING_PANTHEON, BUILDING_LARARIUM,
+    BUILDING_ORACLE, BUILDING_NYMPHAEUM, BUILDING_SMALL_MAUSOLEUM, BUILDING_LARGE_MAUSOLEUM,
+    BUILDING_WHEAT_FARM, BUILDING_VEGETABLE_FARM, BUILDING_FRUIT_FARM, BUILDING_OLIVE_FARM, BUILDING_VINES_FARM,
+    BUILDING_PIG_FARM, BUILDING_MARBLE_QUARRY, BUILDING_IRON_MINE, BUILDING_TIMBER_YARD, BUILDING_CLAY_PIT,
+    BUILDING_WINE_WORKSHOP, BUILDING_OIL_WORKSHOP, BUILDING_WEAPONS_WORKSHOP, BUILDING_FURNITURE_WORKSHOP,
+    BUILDING_POTTERY_WORKSHOP, BUILDING_WHARF, BUILDING_DOCK
+};
+
+#define NUM_COUNTED_TYPES (int) (sizeof(COUNTED_TYPES) / sizeof(building_type))
+
+static void count_building(const building *b)
 {
-    clear_counters();
-    city_buildings_reset_dock_wharf_counters();
-    city_health_reset_hospital_workers();
+    int type = b->type;
+    switch (type) {
+        // SPECIAL TREATMENT
+        // entertainment venues
+        case BUILDING_THEATER:
+        case BUILDING_AMPHITHEATER:
+        case BUILDING_COLOSSEUM:
+        case BUILDING_HIPPODROME:
+        case BUILDING_ARENA:
+        case BUILDING_BARRACKS:
+        case BUILDING_HOSPITAL:
+            increase_count(type, b->num_workers > 0, b->upgrade_level);
+            break;
+
+        // water
+        case BUILDING_RESERVOIR:
+        case BUILDING_FOUNTAIN:
+            increase_count(type, b->has_water_access, b->upgrade_level);
+            break;
+
+        // DEFAULT TREATMENT
+        // education
+        case BUILDING_SCHOOL:
+        case BUILDING_LIBRARY:
+        case BUILDING_ACADEMY:
+        case BUILDING_MISSION_POST:
+        // health
+        case BUILDING_BARBER:
+        case BUILDING_BATHHOUSE:
+        case BUILDING_DOCTOR:
+        // government
+        case BUILDING_FORUM:
+        case BUILDING_FORUM_UPGRADED:
+        case BUILDING_SENATE:
+        case BUILDING_SENATE_UPGRADED:
+        // entertainment schools
+        case BUILDING_ACTOR_COLONY:
+        case BUILDING_GLADIATOR_SCHOOL:
+        case BUILDING_LION_HOUSE:
+        case BUILDING_CHARIOT_MAKER:
+        // distribution
+        case BUILDING_MARKET:
+        case BUILDING_TAVERN:
+        case BUILDING_CARAVANSERAI:
+        // military
+        case BUILDING_MILITARY_ACADEMY:
+        case BUILDING_MESS_HALL:
+        // religion
+        case BUILDING_SMALL_TEMPLE_CERES:
+        case BUILDING_SMALL_TEMPLE_NEPTUNE:
+        case BUILDING_SMALL_TEMPLE_MERCURY:
+        case BUILDING_SMALL_TEMPLE_MARS:
+        case BUILDING_SMALL_TEMPLE_VENUS:
+        case BUILDING_LARGE_TEMPLE_CERES:
+        case BUILDING_LARGE_TEMPLE_NEPTUNE:
+        case BUILDING_LARGE_TEMPLE_MERCURY:
+        case BUILDING_LARGE_TEMPLE_MARS:
+        case BUILDING_LARGE_TEMPLE_VENUS:
+        case BUILDING_GRAND_TEMPLE_CERES:
+        case BUILDING_GRAND_TEMPLE_NEPTUNE:
+        case BUILDING_GRAND_TEMPLE_MERCURY:
+        case BUILDING_GRAND_TEMPLE_MARS:
+        case BUILDING_GRAND_TEMPLE_VENUS:
+        case BUILDING_PANTHEON:
+        case BUILDING_LARARIUM:
+            increase_count(type, b->num_workers > 0, b->upgrade_level);
+            break;
+        case BUILDING_ORACLE:
+        case BUILDING_NYMPHAEUM:
+        case BUILDING_SMALL_MAUSOLEUM:
+        case BUILDING_LARGE_MAUSOLEUM:
+            increase_count(type, b->data.monument.phase == MONUMENT_FINISHED, b->upgrade_level);
+            break;
+        // industry
+        case BUILDING_WHEAT_FARM:
+            increase_industry_count(RESOURCE_WHEAT, b->num_workers > 0);
+            break;
+        case BUILDING_VEGETABLE_FARM:
+            increase_industry_count(RESOURCE_VEGETABLES, b->num_workers > 0);
+            break;
+        case BUILDING_FRUIT_FARM:
+            increase_industry_count(RESOURCE_FRUIT, b->num_workers > 0);
+            break;
+        case BUILDING_OLIVE_FARM:
+            increase_industry_count(RESOURCE_OLIVES, b->num_workers > 0);
+            break;
+        case BUILDING_VINES_FARM:
+            increase_industry_count(RESOURCE_VINES, b->num_workers > 0);
+            break;
+        case BUILDING_PIG_FARM:
+            increase_industry_count(RESOURCE_MEAT, b->num_workers > 0);
+            break;
+        case BUILDING_MARBLE_QUARRY:
+            increase_industry_count(RESOURCE_MARBLE, b->num_workers > 0);
+            break;
+        case BUILDING_IRON_MINE:
+            increase_industry_count(RESOURCE_IRON, b->num_workers > 0);
+            break;
+        case BUILDING_TIMBER_YARD:
+            increase_industry_count(RESOURCE_TIMBER, b->num_workers > 0);
+            break;
+        case BUILDING_CLAY_PIT:
+            increase_industry_count(RESOURCE_CLAY, b->num_workers > 0);
+            break;
+        case BUILDING_WINE_WORKSHOP:
+            increase_industry_count(RESOURCE_WINE, b->num_workers > 0);
+            break;
+        case BUILDING_OIL_WORKSHOP:
+            increase_industry_count(RESOURCE_OIL, b->num_workers > 0);
+            break;
+        case BUILDING_WEAPONS_WORKSHOP:
+            increase_industry_count(RESOURCE_WEAPONS, b->num_workers > 0);
+            break;
+        case BUILDING_FURNITURE_WORKSHOP:
+            increase_industry_count(RESOURCE_FURNITURE, b->num_workers > 0);
+            break;
+        case BUILDING_POTTERY_WORKSHOP:
+            increase_industry_count(RESOURCE_POTTERY, b->num_workers > 0);
+            break;
+
+        // water-side
+        case BUILDING_WHARF:
+            increase_industry_count(RESOURCE_MEAT, b->num_workers > 0 && b->data.industry.fishing_boat_id);
+            break;
+        default:
+            break;
+    }
+}
+
+// The work done on the side for every counted building
+static void update_building(building *b)
+{
+    int is_entertainment_venue = 0;
+    switch (b->type) {
+        case BUILDING_THEATER:
+        case BUILDING_AMPHITHEATER:
+        case BUILDING_COLOSSEUM:
+        case BUILDING_HIPPODROME:
+        case BUILDING_ARENA:
+            is_entertainment_venue = 1;
+            break;
+        case BUILDING_BARRACKS:
+            city_buildings_set_barracks(b->id);
+            break;
+        case BUILDING_HOSPITAL:
+            city_health_add_hospital_workers(b->num_workers);
+            break;
+        case BUILDING_WHARF:
+            if (b->num_workers > 0) {
+                city_buildings_add_working_wharf(!b->data.industry.fishing_boat_id);
+            }
+            break;
+        case BUILDING_DOCK:
+            if (b->num_workers > 0 && b->has_water_access) {
+                city_buildings_add_working_dock(b->id);
+            }
+            break;
+        default:
+            break;
+    }
+    if (b->immigrant_figure_id) {
+        figure *f = figure_get(b->immigrant_figure_id);
+        if (f->state != FIGURE_STATE_ALIVE || f->destination_building_id != b->id) {
+            b->immigrant_figure_id = 0;
+        }
+    }
+    if (is_entertainment_venue && (!building_monument_is_monument(b) || b->data.monument.phase == MONUMENT_FINISHED)) {
+        // update number of shows
+        int shows = 0;
+        if (b->data.entertainment.days1 > 0) {
+            --b->data.entertainment.days1;
+            ++shows;
+        }
+        if (b->data.entertainment.days2 > 0) {
+            --b->data.entertainment.days2;
+            ++shows;
+        }
+        b->data.entertainment.num_shows = shows;
+    }
+}
+
+#ifdef VALIDATE_BUILDING_COUNTS
+static int is_counted_type(building_type type)
+{
+    for (int i = 0; i < NUM_COUNTED_TYPES; i++) {
+        if (COUNTED_TYPES[i] == type) {
+            return 1;
+        }
+    }
+    return 0;
+}
 
+// Checks, by walking every building, what the recount through the type lists relies on:
+// the lists hold every building of their type, and the types that are not visited are never counted
+static void validate_counts(void)
+{
+    int listed[BUILDING_TYPE_MAX] = { 0 };
+    int walked[BUILDING_TYPE_MAX] = { 0 };
+    for (building_type type = BUILDING_NONE; type < BUILDING_TYPE_MAX; type++) {
+        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
+            if (b->state == BUILDING_STATE_IN_USE && !b->house_size) {
+                listed[type]++;
+            }
+        }
+    }
+    struct record buildings[BUILDING_TYPE_MAX];
+    struct record industry[RESOURCE_MAX];
+    memcpy(buildings, data.buildings, sizeof(buildings));
+    memcpy(industry, data.industry, sizeof(industry));
+    clear_counters();
     for (int i = 1; i < building_count(); i++) {
-        building *b = building_get(i);
+        const building *b = building_get(i);
         if (b->state != BUILDING_STATE_IN_USE || b->house_size) {
             continue;
         }
-        int is_entertainment_venue = 0;
-        int type = b->type;
-        switch (type) {
-            // SPECIAL TREATMENT
-            // entertainment venues
-            case BUILDING_THEATER:
-            case BUILDING_AMPHITHEATER:
-            case BUILDING_COLOSSEUM:
-            case BUILDING_HIPPODROME:
-            case BUILDING_ARENA:
-                is_entertainment_venue = 1;
-                increase_count(type, b->num_workers > 0, b->upgrade_level);
-                break;
-
-            case BUILDING_BARRACKS:
-                city_buildings_set_barracks(i);
-                increase_count(type, b->num_workers > 0, b->upgrade_level);
-                break;
-
-            case BUILDING_HOSPITAL:
-                increase_count(type, b->num_workers > 0, b->upgrade_level);
-                city_health_add_hospital_workers(b->num_workers);
-                break;
-
-            // water
-            case BUILDING_RESERVOIR:
-            case BUILDING_FOUNTAIN:
-                increase_count(type, b->has_water_access, b->upgrade_level);
-                break;
-
-            // DEFAULT TREATMENT
-            // education
-            case BUILDING_SCHOOL:
-            case BUILDING_LIBRARY:
-            case BUILDING_ACADEMY:
-            case BUILDING_MISSION_POST:
-            // health
-            case BUILDING_BARBER:
-            case BUILDING_BATHHOUSE:
-            case BUILDING_DOCTOR:
-            // government
-            case BUILDING_FORUM:
-            case BUILDING_FORUM_UPGRADED:
-            case BUILDING_SENATE:
-            case BUILDING_SENATE_UPGRADED:
-            // entertainment schools
-            case BUILDING_ACTOR_COLONY:
-            case BUILDING_GLADIATOR_SCHOOL:
-            case BUILDING_LION_HOUSE:
-            case BUILDING_CHARIOT_MAKER:
-            // distribution
-            case BUILDING_MARKET:
-            case BUILDING_TAVERN:
-            case BUILDING_CARAVANSERAI:
-            // military
-            case BUILDING_MILITARY_ACADEMY:
-            case BUILDING_MESS_HALL:
-            // religion
-            case BUILDING_SMALL_TEMPLE_CERES:
-            case BUILDING_SMALL_TEMPLE_NEPTUNE:
-            case BUILDING_SMALL_TEMPLE_MERCURY:
-            case BUILDING_SMALL_TEMPLE_MARS:
-            case BUILDING_SMALL_TEMPLE_VENUS:
-            case BUILDING_LARGE_TEMPLE_CERES:
-            case BUILDING_LARGE_TEMPLE_NEPTUNE:
-            case BUILDING_LARGE_TEMPLE_MERCURY:
-            case BUILDING_LARGE_TEMPLE_MARS:
-            case BUILDING_LARGE_TEMPLE_VENUS:
-            case BUILDING_GRAND_TEMPLE_CERES:
-            case BUILDING_GRAND_TEMPLE_NEPTUNE:
-            case BUILDING_GRAND_TEMPLE_MERCURY:
-            case BUILDING_GRAND_TEMPLE_MARS:
-            case BUILDING_GRAND_TEMPLE_VENUS:
-            case BUILDING_PANTHEON:
-            case BUILDING_LARARIUM:
-                increase_count(type, b->num_workers > 0, b->upgrade_level);
-                break;
-            case BUILDING_ORACLE:
-            case BUILDING_NYMPHAEUM:
-            case BUILDING_SMALL_MAUSOLEUM:
-            case BUILDING_LARGE_MAUSOLEUM:
-                increase_count(type, b->data.monument.phase == MONUMENT_FINISHED, b->upgrade_level);
-                break;
-            // industry
-            case BUILDING_WHEAT_FARM:
-                increase_industry_count(RESOURCE_WHEAT, b->num_workers > 0);
-                break;
-            case BUILDING_VEGETABLE_FARM:
-                increase_industry_count(RESOURCE_VEGETABLES, b->num_workers > 0);
-                break;
-            case BUILDING_FRUIT_FARM:
-                increase_industry_count(RESOURCE_FRUIT, b->num_workers > 0);
-                break;
-            case BUILDING_OLIVE_FARM:
-                increase_industry_count(RESOURCE_OLIVES, b->num_workers > 0);
-                break;
-            case BUILDING_VINES_FARM:
-                increase_industry_count(RESOURCE_VINES, b->num_workers > 0);
-                break;
-            case BUILDING_PIG_FARM:
-                increase_industry_count(RESOURCE_MEAT, b->num_workers > 0);
-                break;
-            case BUILDING_MARBLE_QUARRY:
-                increase_industry_count(RESOURCE_MARBLE, b->num_workers > 0);
-                break;
-            case BUILDING_IRON_MINE:
-                increase_industry_count(RESOURCE_IRON, b->num_workers > 0);
-                break;
-            case BUILDING_TIMBER_YARD:
-                increase_industry_count(RESOURCE_TIMBER, b->num_workers > 0);
-                break;
-            case BUILDING_CLAY_PIT:
-                increase_industry_count(RESOURCE_CLAY, b->num_workers > 0);
-                break;
-            case BUILDING_WINE_WORKSHOP:
-                increase_industry_count(RESOURCE_WINE, b->num_workers > 0);
-                break;
-            case BUILDING_OIL_WORKSHOP:
-                increase_industry_count(RESOURCE_OIL, b->num_workers > 0);
-                break;
-            case BUILDING_WEAPONS_WORKSHOP:
-                increase_industry_count(RESOURCE_WEAPONS, b->num_workers > 0);
-                break;
-            case BUILDING_FURNITURE_WORKSHOP:
-                increase_industry_count(RESOURCE_FURNITURE, b->num_workers > 0);
-                break;
-            case BUILDING_POTTERY_WORKSHOP:
-                increase_industry_count(RESOURCE_POTTERY, b->num_workers > 0);
-                break;
-
-            // water-side
-            case BUILDING_WHARF:
-                if (b->num_workers > 0) {
-                    city_buildings_add_working_wharf(!b->data.industry.fishing_boat_id);
-                }
-                increase_industry_count(RESOURCE_MEAT, b->num_workers > 0 && b->data.industry.fishing_boat_id);
-                break;
-            case BUILDING_DOCK:
-                if (b->num_workers > 0 && b->has_water_access) {
-                    city_buildings_add_working_dock(i);
-                }
-                break;
-            default:
-                continue;
+        walked[b->type]++;
+        if (!is_counted_type(b->type)) {
+            count_building(b);
         }
-        if (b->immigrant_figure_id) {
-            figure *f = figure_get(b->immigrant_figure_id);
-            if (f->state != FIGURE_STATE_ALIVE || f->destination_building_id != i) {
-                b->immigrant_figure_id = 0;
-            }
+    }
+    for (int i = 0; i < BUILDING_TYPE_MAX; i++) {
+        if (listed[i] != walked[i]) {
+            log_error("Building type list does not hold every building of type", 0, i);
         }
-        if (is_entertainment_venue && (!building_monument_is_monument(b) || b->data.monument.phase == MONUMENT_FINISHED)) {
-            // update number of shows
-            int shows = 0;
-            if (b->data.entertainment.days1 > 0) {
-                --b->data.entertainment.days1;
-                ++shows;
-            }
-            if (b->data.entertainment.days2 > 0) {
-                --b->data.entertainment.days2;
-                ++shows;
+        if (data.buildings[i].total) {
+            log_error("Building type is counted but not visited by the recount", 0, i);
+        }
+    }
+    for (int i = 0; i < RESOURCE_MAX; i++) {
+        if (data.industry[i].total) {
+            log_error("Industry is counted but not visited by the recount for resource", 0, i);
+        }
+    }
+    memcpy(data.buildings, buildings, sizeof(buildings));
+    memcpy(data.industry, industry, sizeof(industry));
+}
+#endif
+
+void building_count_update(void)
+{
+    clear_counters();
+    city_buildings_reset_dock_wharf_counters();
+    city_health_reset_hospital_workers();
+
+    // only the types that are counted are visited, houses and the other buildings are skipped
+    for (int i = 0; i < NUM_COUNTED_TYPES; i++) {
+        for (building *b = building_first_of_type(COUNTED_TYPES[i]); b; b = b->next_of_type) {
+            if (b->state != BUILDING_STATE_IN_USE || b->house_size) {
+                continue;
             }
-            b->data.entertainment.num_shows = shows;
+            count_building(b);
+            update_building(b);
         }
     }
     limit_hippodrome();
+#ifdef VALIDATE_BUILDING_COUNTS
+    validate_counts();
+#endif
 }
 
 int building_count_grand_temples(void)
@@ -319,7 +427,7 @@ void building_count_save_state(buffer *industry, buffer *culture1, buffer *cultu
     for (int i = 0; i < buffer_count; i++) {
         buffer *buf = buffer_pointers[i];
         int buf_size = buffer_sizes[i] + 4; // Extra 4 bytes to store buffer size
-        uint8_t *buf_data = malloc(buf_size);
+        uint8_t *buf_data = calloc(1, buf_size);
         buffer_init(buf, buf_data, buf_size);
         buffer_write_i32(buf, buf_size);
     }
@@ -112,9 +112,7 @@ static void merge(building *b)
         b->data.house.inventory[i] += merge_data.inventory[i];
     }
     map_building_tiles_remove(b->id, b->x, b->y);
-    b->x = merge_data.x;
-    b->y = merge_data.y;
-    b->grid_offset = map_grid_offset(b->x, b->y);
+    building_set_position(b, merge_data.x, merge_data.y);
     b->house_is_merged = 1;
     map_building_tiles_add(b->id, b->x, b->y, 2, building_image_get(b), TERRAIN_BUILDING);
 }
@@ -381,9 +379,7 @@ void building_house_expand_to_large_insula(building *house)
         house->data.house.inventory[i] += merge_data.inventory[i];
     }
     map_building_tiles_remove(house->id, house->x, house->y);
-    house->x = merge_data.x;
-    house->y = merge_data.y;
-    house->grid_offset = map_grid_offset(house->x, house->y);
+    building_set_position(house, merge_data.x, merge_data.y);
     map_building_tiles_add(house->id, house->x, house->y, house->size, building_image_get(house), TERRAIN_BUILDING);
 }
 
@@ -401,9 +397,7 @@ void building_house_expand_to_large_villa(building *house)
         house->data.house.inventory[i] += merge_data.inventory[i];
     }
     map_building_tiles_remove(house->id, house->x, house->y);
-    house->x = merge_data.x;
-    house->y = merge_data.y;
-    house->grid_offset = map_grid_offset(house->x, house->y);
+    building_set_position(house, merge_data.x, merge_data.y);
     map_building_tiles_add(house->id, house->x, house->y, house->size, building_image_get(house), TERRAIN_BUILDING);
 }
 
@@ -421,9 +415,7 @@ void building_house_expand_to_large_palace(building *house)
         house->data.house.inventory[i] += merge_data.inventory[i];
     }
     map_building_tiles_remove(house->id, house->x, house->y);
-    house->x = merge_data.x;
-    house->y = merge_data.y;
-    house->grid_offset = map_grid_offset(house->x, house->y);
+    building_set_position(house, merge_data.x, merge_data.y);
     map_building_tiles_add(house->id, house->x, house->y, house->size, building_image_get(house), TERRAIN_BUILDING);
 }
 
@@ -534,9 +526,7 @@ void building_house_check_for_corruption(building *house)
             for (int x = 0; x < map_width; x++) {
                 int grid_offset = map_grid_offset(x, y);
                 if (map_building_at(grid_offset) == house->id) {
-                    house->grid_offset = grid_offset;
-                    house->x = map_grid_offset_to_x(grid_offset);
-                    house->y = map_grid_offset_to_y(grid_offset);
+                    building_set_position(house, x, y);
                     building_totals_add_corrupted_house(0);
                     return;
                 }
@@ -98,7 +98,7 @@ void building_list_save_state(buffer *small, buffer *large, buffer *burning, buf
     int buf_size = data.small.size * sizeof(int32_t);
     int *value;
     if (buf_size) {
-        uint8_t *buf_data = malloc(buf_size);
+        uint8_t *buf_data = calloc(1, buf_size);
         buffer_init(small, buf_data, buf_size);
         array_foreach(data.small, value)
         {
@@ -108,7 +108,7 @@ void building_list_save_state(buffer *small, buffer *large, buffer *burning, buf
 
     buf_size = data.large.size * sizeof(int32_t);
     if (buf_size) {
-        uint8_t *buf_data = malloc(buf_size);
+        uint8_t *buf_data = calloc(1, buf_size);
         buffer_init(large, buf_data, buf_size);
         array_foreach(data.large, value)
         {
@@ -118,7 +118,7 @@ void building_list_save_state(buffer *small, buffer *large, buffer *burning, buf
 
     buf_size = data.burning.size * sizeof(int32_t);
     if (buf_size) {
-        uint8_t *buf_data = malloc(buf_size);
+        uint8_t *buf_data = calloc(1, buf_size);
         buffer_init(burning, buf_data, buf_size);
         array_foreach(data.burning, value)
         {
@@ -20,6 +20,9 @@ void building_rotation_rotate_backward(void);
 void building_rotation_reset_rotation(void);
 void building_rotation_setup_rotation(void);
 
+void building_rotation_get_state(int *rotation, int *extra_rotation, int *road_orientation);
+void building_rotation_set_state(int rotation, int extra_rotation, int road_orientation);
+
 int building_rotation_type_has_rotations(building_type type);
 
 #endif // BUILDING_ROTATION_H
\ No newline at end of file
@@ -36,6 +36,7 @@ void building_storage_clear_all(void)
         !array_next(storages)) { // Ignore first storage
         log_error("Unable to create storages. The game will likely crash.", 0, 0);
     }
+    array_track_used_items(storages);
 }
 
 void building_storage_reset_building_ids(void)
@@ -92,6 +93,7 @@ int building_storage_restore(int storage_id)
 void building_storage_delete(int storage_id)
 {
     array_item(storages, storage_id)->in_use = 0;
+    array_item_released(storages, storage_id);
     array_trim(storages);
 }
 
@@ -189,7 +191,7 @@ void building_storage_accept_none(int storage_id)
 void building_storage_save_state(buffer *buf)
 {
     int buf_size = 4 + storages.size * STORAGE_CURRENT_BUFFER_SIZE;
-    uint8_t *buf_data = malloc(buf_size);
+    uint8_t *buf_data = calloc(1, buf_size);
     buffer_init(buf, buf_data, buf_size);
     buffer_write_i32(buf, STORAGE_CURRENT_BUFFER_SIZE);
 
@@ -222,6 +224,7 @@ void building_storage_load_state(buffer *buf, int includes_storage_size)
         !array_expand(storages, storages_to_load)) {
         log_error("Unable to create storages. The game will likely crash.", 0, 0);
     }
+    array_track_used_items(storages);
 
     int highest_id_in_use = 0;
 
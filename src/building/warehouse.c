@@ -17,6 +17,8 @@
 #include "map/image.h"
 #include "scenario/property.h"
 
+#include <string.h>
+
 #define INFINITE 10000
 
 int building_warehouse_get_space_info(building *warehouse)
@@ -286,6 +288,51 @@ int building_warehouse_is_not_accepting(int resource, building *b)
     return !((building_warehouse_is_accepting(resource, b) || building_warehouse_is_getting(resource, b)));
 }
 
+void building_warehouse_get_accepted_resources(building *b, int *accepting)
+{
+    int amounts[RESOURCE_MAX] = { 0 };
+    building *space = b;
+    for (int i = 0; i < 8; i++) {
+        space = building_next(space);
+        if (space->id <= 0) {
+            // same as building_warehouse_get_amount
+            memset(amounts, 0, sizeof(amounts));
+            break;
+        }
+        if (space->subtype.warehouse_resource_id) {
+            amounts[space->subtype.warehouse_resource_id] += space->loads_stored;
+        }
+    }
+    const building_storage *s = building_storage_get(b->storage_id);
+    for (int r = RESOURCE_NONE; r < RESOURCE_MAX; r++) {
+        if (b->has_plague) {
+            accepting[r] = 0;
+            continue;
+        }
+        switch (s->resource_state[r]) {
+            case BUILDING_STORAGE_STATE_ACCEPTING:
+            case BUILDING_STORAGE_STATE_GETTING:
+                accepting[r] = 1;
+                break;
+            case BUILDING_STORAGE_STATE_ACCEPTING_3QUARTERS:
+            case BUILDING_STORAGE_STATE_GETTING_3QUARTERS:
+                accepting[r] = amounts[r] < THREEQ_WAREHOUSE;
+                break;
+            case BUILDING_STORAGE_STATE_ACCEPTING_HALF:
+            case BUILDING_STORAGE_STATE_GETTING_HALF:
+                accepting[r] = amounts[r] < HALF_WAREHOUSE;
+                break;
+            case BUILDING_STORAGE_STATE_ACCEPTING_QUARTER:
+            case BUILDING_STORAGE_STATE_GETTING_QUARTER:
+                accepting[r] = amounts[r] < QUARTER_WAREHOUSE;
+                break;
+            default:
+                accepting[r] = 0;
+                break;
+        }
+    }
+}
+
 int building_warehouse_get_acceptable_quantity(int resource, building *b)
 {
     const building_storage *s = building_storage_get(b->storage_id);
@@ -31,6 +31,14 @@ int building_warehouse_is_accepting(int resource, building *b);
 int building_warehouse_is_getting(int resource, building *b);
 int building_warehouse_is_not_accepting(int resource, building *b);
 
+/**
+ * Checks all resources at once for whether the warehouse is accepting or getting them.
+ * Equivalent to calling !building_warehouse_is_not_accepting for each resource, but walks the spaces only once
+ * @param b Warehouse
+ * @param accepting Array of RESOURCE_MAX items, set to 1 for each resource the warehouse accepts or gets
+ */
+void building_warehouse_get_accepted_resources(building *b, int *accepting);
+
 int building_warehouse_remove_resource(building *warehouse, int resource, int amount);
 
 void building_warehouse_remove_resource_curse(building *warehouse, int amount);
@@ -1,12 +1,21 @@
 #include "buildings.h"
 
 #include "city/data_private.h"
+#include "core/array.h"
 #include "core/calc.h"
 
 #define NUM_PLAGUE_BUILDINGS sizeof(PLAGUE_BUILDINGS) / sizeof(building_type)
+#define NUM_HOUSE_TYPES (BUILDING_HOUSE_LUXURY_PALACE - BUILDING_HOUSE_SMALL_TENT + 1)
+#define PLAGUE_SIZE_STEP 100
 
 static const building_type PLAGUE_BUILDINGS[] = { BUILDING_DOCK, BUILDING_WAREHOUSE, BUILDING_GRANARY };
 
+// Buildings that had the plague when last checked, some of them may have been cured since
+static struct {
+    array(int) ids;
+    int is_valid;
+} plague;
+
 int city_buildings_has_senate(void)
 {
     return city_data.building.senate_placed;
@@ -251,51 +260,128 @@ int city_buildings_unknown_value(void)
     return city_data.building.unknown_value;
 }
 
-int city_buildings_get_closest_plague(int x, int y, int *distance)
+// Order in which buildings with the plague are visited: houses by type, then docks, warehouses and granaries
+static int get_plague_order(building_type type)
 {
-    int min_free_building_id = 0;
-    int min_occupied_building_id = 0;
-    int min_occupied_dist = *distance = 10000;
+    if (type >= BUILDING_HOUSE_SMALL_TENT && type <= BUILDING_HOUSE_LUXURY_PALACE) {
+        return type - BUILDING_HOUSE_SMALL_TENT;
+    }
+    for (int i = 0; i < NUM_PLAGUE_BUILDINGS; i++) {
+        if (PLAGUE_BUILDINGS[i] == type) {
+            return NUM_HOUSE_TYPES + i;
+        }
+    }
+    return -1;
+}
 
-    // Find closest in houses
+static void add_plague_id(int building_id)
+{
+    if (!plague.ids.blocks && !array_init(plague.ids, PLAGUE_SIZE_STEP, 0, 0)) {
+        return;
+    }
+    int *id;
+    array_foreach(plague.ids, id) {
+        if (*id == building_id) {
+            return;
+        }
+    }
+    id = array_advance(plague.ids);
+    if (id) {
+        *id = building_id;
+    }
+}
+
+static void rebuild_plague_list(void)
+{
+    plague.ids.size = 0;
     for (building_type type = BUILDING_HOUSE_SMALL_TENT; type <= BUILDING_HOUSE_LUXURY_PALACE; type++) {
         for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->has_plague && b->distance_from_entry) {
-                int dist = calc_maximum_distance(x, y, b->x, b->y);
-                if (b->figure_id4) {
-                    if (dist < min_occupied_dist) {
-                        min_occupied_dist = dist;
-                        min_occupied_building_id = b->id;
-                    }
-                } else if (dist < *distance) {
-                    *distance = dist;
-                    min_free_building_id = b->id;
-                }
+            if (b->has_plague) {
+                add_plague_id(b->id);
             }
         }
     }
-
-    // Find closest in buildings (docks, granaries or warehouses)
     for (int i = 0 ; i < NUM_PLAGUE_BUILDINGS; i++) {
-        building_type type = PLAGUE_BUILDINGS[i];
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->has_plague && b->distance_from_entry) {
-                int dist = calc_maximum_distance(x, y, b->x, b->y);
-                if (b->figure_id4) {
-                    if (dist < min_occupied_dist) {
-                        min_occupied_dist = dist;
-                        min_occupied_building_id = b->id;
-                    }
-                } else if (dist < *distance) {
-                    *distance = dist;
-                    min_free_building_id = b->id;
-                }
+        for (building *b = building_first_of_type(PLAGUE_BUILDINGS[i]); b; b = b->next_of_type) {
+            if (b->has_plague) {
+                add_plague_id(b->id);
             }
         }
     }
+    plague.is_valid = 1;
+}
+
+/**
+ * Returns the building at the given position of the plague list, or removes the entry if that building
+ * no longer has the plague. In that case the last entry is moved into its place.
+ */
+static building *get_plague_building(int index)
+{
+    building *b = building_get(*array_item(plague.ids, index));
+    if (b->state != BUILDING_STATE_UNUSED && b->has_plague && get_plague_order(b->type) >= 0) {
+        return b;
+    }
+    *array_item(plague.ids, index) = *array_item(plague.ids, plague.ids.size - 1);
+    plague.ids.size--;
+    return 0;
+}
+
+static int visited_before(const building *b, const building *other)
+{
+    int order = get_plague_order(b->type);
+    int other_order = get_plague_order(other->type);
+    return order < other_order || (order == other_order && b->id < other->id);
+}
 
+void city_buildings_reset_plague(void)
+{
+    plague.is_valid = 0;
+}
+
+void city_buildings_add_plague(building *b)
+{
+    if (plague.is_valid) {
+        add_plague_id(b->id);
+    }
+}
+
+int city_buildings_get_closest_plague(int x, int y, int *distance)
+{
+    building *min_free_building = 0;
+    building *min_occupied_building = 0;
+    int min_occupied_dist = *distance = 10000;
+
+    if (!plague.is_valid) {
+        rebuild_plague_list();
+    }
+    for (int i = 0; i < plague.ids.size; i++) {
+        building *b = get_plague_building(i);
+        if (!b) {
+            // another entry was moved into this position
+            i--;
+            continue;
+        }
+        if (!b->distance_from_entry) {
+            continue;
+        }
+        // ties go to the building that comes first in the order of the building type lists
+        int dist = calc_maximum_distance(x, y, b->x, b->y);
+        if (b->figure_id4) {
+            if (dist < min_occupied_dist ||
+                (dist == min_occupied_dist && min_occupied_building && visited_before(b, min_occupied_building))) {
+                min_occupied_dist = dist;
+                min_occupied_building = b;
+            }
+        } else if (dist < *distance ||
+            (dist == *distance && min_free_building && visited_before(b, min_free_building))) {
+            *distance = dist;
+            min_free_building = b;
+        }
+    }
+
+    int min_free_building_id = min_free_building ? min_free_building->id : 0;
     if (!min_free_building_id && min_occupied_dist <= 2) {
-        min_free_building_id = min_occupied_building_id;
+        min_free_building_id = min_occupied_building ? min_occupied_building->id : 0;
         *distance = 2;
     }
     return min_free_building_id;
@@ -323,16 +409,15 @@ static void update_sickness_duration(int building_id)
 
 void city_buildings_update_plague(void)
 {
-    for (building_type type = BUILDING_HOUSE_SMALL_TENT; type <= BUILDING_HOUSE_LUXURY_PALACE; type++) {
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            update_sickness_duration(b->id);
-        }
+    if (!plague.is_valid) {
+        rebuild_plague_list();
     }
-
-    for (int i = 0 ; i < NUM_PLAGUE_BUILDINGS; i++) {
-        building_type type = PLAGUE_BUILDINGS[i];
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            update_sickness_duration(b->id);
+    for (int i = 0; i < plague.ids.size; i++) {
+        building *b = get_plague_building(i);
+        if (!b) {
+            i--;
+            continue;
         }
+        update_sickness_duration(b->id);
     }
 }
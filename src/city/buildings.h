@@ -54,6 +54,17 @@ void city_buildings_set_mission_post_operational(void);
 
 int city_buildings_unknown_value(void);
 
+/**
+ * Forgets the buildings known to have the plague. Called when a game is started or loaded
+ */
+void city_buildings_reset_plague(void);
+
+/**
+ * Registers a building that just got the plague
+ * @param b Building that has the plague
+ */
+void city_buildings_add_plague(building *b);
+
 int city_buildings_get_closest_plague(int x, int y, int *distance);
 void city_buildings_update_plague(void);
 
@@ -1,5 +1,6 @@
 #include "data.h"
 
+#include "city/buildings.h"
 #include "city/constants.h"
 #include "city/data_private.h"
 #include "city/gods.h"
@@ -11,6 +12,7 @@
 void city_data_init(void)
 {
     memset(&city_data, 0, sizeof(struct city_data_t));
+    city_buildings_reset_plague();
 
     city_data.unused.faction_bytes[0] = 0;
     city_data.unused.faction_bytes[1] = 0;
@@ -1104,6 +1106,7 @@ void city_data_load_state(buffer *main, buffer *faction, buffer *faction_unknown
     buffer *entry_exit_xy, buffer *entry_exit_grid_offset, int has_separate_import_limits)
 {
     load_main_data(main, has_separate_import_limits);
+    city_buildings_reset_plague();
 
     city_data.unused.faction_id = buffer_read_i32(faction);
     city_data.unused.faction_bytes[0] = buffer_read_i8(faction_unknown);
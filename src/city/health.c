@@ -7,6 +7,7 @@
 #include "building/model.h"
 #include "building/monument.h"
 #include "building/warehouse.h"
+#include "city/buildings.h"
 #include "city/culture.h"
 #include "city/data_private.h"
 #include "city/message.h"
@@ -65,6 +66,7 @@ static void cause_disease_in_building(int building_id)
         // Set building to plague status and use fire process to manage plague on it
         b->has_plague = 1;
         b->sickness_duration = 0;
+        city_buildings_add_plague(b);
 
         if (is_plague_building(b->type)) {
             city_message_post(1, MESSAGE_SICKNESS, b->type, b->grid_offset);
@@ -138,6 +140,7 @@ static int cause_disease(void)
                         b->immigrant_figure_id = 0;
                         b->has_plague = 1;
                         b->sickness_duration = 0;
+                        city_buildings_add_plague(b);
                     }
                 }
             }
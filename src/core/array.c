@@ -28,3 +28,61 @@ void array_free(void **data, int blocks)
     }
     free(data);
 }
+
+int array_usage_next(const array_usage *usage, int position, int size)
+{
+    while (position < size && position < usage->tracked_size) {
+        unsigned int word = usage->maybe_unused[position >> 5] >> (position & 31);
+        if (word) {
+            while (!(word & 1)) {
+                word >>= 1;
+                position++;
+            }
+            // bits past the tracked size are not kept up to date
+            if (position > usage->tracked_size) {
+                position = usage->tracked_size;
+            }
+            break;
+        }
+        position = (position | 31) + 1;
+        if (position > usage->tracked_size) {
+            position = usage->tracked_size;
+        }
+    }
+    return position < size ? position : size;
+}
+
+void array_usage_set(array_usage *usage, int position, int in_use)
+{
+    if (position >= usage->tracked_size) {
+        if (!in_use) {
+            return;
+        }
+        int words_needed = (position >> 5) + 1;
+        if (words_needed > usage->words) {
+            int new_words = words_needed * 2;
+            unsigned int *new_bits = realloc(usage->maybe_unused, sizeof(unsigned int) * new_words);
+            if (!new_bits) {
+                // fall back to checking every item
+                usage->enabled = 0;
+                return;
+            }
+            usage->maybe_unused = new_bits;
+            usage->words = new_words;
+        }
+        for (int i = usage->tracked_size; i < position; i++) {
+            usage->maybe_unused[i >> 5] |= 1u << (i & 31);
+        }
+        usage->tracked_size = position + 1;
+    }
+    if (in_use) {
+        usage->maybe_unused[position >> 5] &= ~(1u << (position & 31));
+    } else {
+        usage->maybe_unused[position >> 5] |= 1u << (position & 31);
+    }
+}
+
+void array_usage_free(array_usage *usage)
+{
+    free(usage->maybe_unused);
+}
@@ -4,6 +4,17 @@
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * Private structure that keeps track of which array items may be unused. Bits are set for items that may be unused
+ * and cleared for items known to be in use. Items from tracked_size onwards may all be unused.
+ */
+typedef struct {
+    unsigned int *maybe_unused;
+    int words;
+    int tracked_size;
+    int enabled;
+} array_usage;
+
 /**
  * Creates an array structure
  * @param T The type of item that the array holds
@@ -17,6 +28,7 @@ struct { \
     int bit_offset; \
     void (*constructor)(T *, int); \
     int (*in_use)(const T *); \
+    array_usage usage; \
 }
 
 /**
@@ -36,6 +48,7 @@ struct { \
 #define array_init(a, size, new_item_callback, in_use_callback) \
 ( \
     array_free((void **)(a).items, (a).blocks), \
+    array_usage_free(&(a).usage), \
     memset(&(a), 0, sizeof(a)), \
     (a).constructor = new_item_callback, \
     (a).in_use = in_use_callback, \
@@ -55,6 +68,7 @@ struct { \
 { \
     ptr = 0; \
     int error = 0; \
+    int item_position = 0; \
     while ((a).size < index) { \
         if (!array_advance(a)) { \
             error = 1; \
@@ -62,20 +76,74 @@ struct { \
         } \
     } \
     if (!error && (a).in_use) { \
-        for (int i = index; i < (a).size; i++) { \
+        for (int i = array_usage_next_candidate(a, index); i < (a).size; i = array_usage_next_candidate(a, i + 1)) { \
             if (!(a).in_use(array_item(a, i))) { \
                 ptr = array_item(a, i); \
+                item_position = i; \
                 memset(ptr, 0, sizeof(**(a).items)); \
                 if ((a).constructor) { \
                     (a).constructor(ptr, i); \
                 } \
                 break; \
             } \
+            if ((a).usage.enabled) { \
+                array_usage_set(&(a).usage, i, 1); \
+            } \
         } \
     } \
     if (!error && !ptr) { \
+        item_position = (a).size; \
         ptr = array_advance(a); \
     } \
+    if (ptr && (a).usage.enabled) { \
+        array_usage_set(&(a).usage, item_position, 1); \
+    } \
+}
+
+/**
+ * Makes array_new_item skip the items that are known to be in use, instead of checking them one by one.
+ * When enabled, every item that stops being in use MUST be reported with array_item_released,
+ * and the caller of array_new_item must set the new item as in use.
+ * array_new_item returns the same items as it would without tracking.
+ * Tracking is disabled by array_init.
+ * @param a The array structure
+ */
+#define array_track_used_items(a) \
+{ \
+    (a).usage.enabled = 1; \
+    (a).usage.tracked_size = 0; \
+}
+
+/**
+ * Reports that an item of an array with tracking enabled is no longer in use.
+ * @param a The array structure
+ * @param position The position of the item
+ */
+#define array_item_released(a, position) \
+{ \
+    if ((a).usage.enabled) { \
+        array_usage_set(&(a).usage, position, 0); \
+    } \
+}
+
+/**
+ * Forgets which items are known to be in use, for when items may have stopped being in use without being reported.
+ * @param a The array structure
+ */
+#define array_forget_used_items(a) \
+{ \
+    (a).usage.tracked_size = 0; \
+}
+
+/**
+ * Frees the memory of an array. The array can be used again after calling array_init
+ * @param a The array structure
+ */
+#define array_clear(a) \
+{ \
+    array_free((void **)(a).items, (a).blocks); \
+    array_usage_free(&(a).usage); \
+    memset(&(a), 0, sizeof(a)); \
 }
 
 /**
@@ -137,6 +205,9 @@ struct { \
             (a).size--; \
         } \
     } \
+    if ((a).usage.tracked_size > (a).size) { \
+        (a).usage.tracked_size = (a).size; \
+    } \
 }
 
 /**
@@ -182,6 +253,27 @@ int array_add_blocks(void ***data, int *blocks, int items_per_block, int item_si
  */
 void array_free(void **data, int blocks);
 
+/**
+ * This definition is private and should not be used
+ */
+#define array_usage_next_candidate(a, position) \
+    ( (a).usage.enabled ? array_usage_next(&(a).usage, position, (a).size) : (position) )
+
+/**
+ * This function is private and should not be used
+ */
+int array_usage_next(const array_usage *usage, int position, int size);
+
+/**
+ * This function is private and should not be used
+ */
+void array_usage_set(array_usage *usage, int position, int in_use);
+
+/**
+ * This function is private and should not be used
+ */
+void array_usage_free(array_usage *usage);
+
 /**
  * Private helper compile-time functions for finding the next power of two into which a number fits
  */
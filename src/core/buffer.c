@@ -2,6 +2,12 @@
 
 #include <string.h>
 
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define HOST_IS_LITTLE_ENDIAN 1
+#else
+#define HOST_IS_LITTLE_ENDIAN 0
+#endif
+
 void buffer_init(buffer *buf, void *data, int size)
 {
     buf->data = data;
@@ -55,6 +61,48 @@ void buffer_write_u32(buffer *buf, uint32_t value)
     }
 }
 
+static int items_that_fit(buffer *buf, int count, int item_size)
+{
+    int available = (buf->size - buf->index) / item_size;
+    if (count > available) {
+        buf->overflow = 1;
+        return available > 0 ? available : 0;
+    }
+    return count;
+}
+
+void buffer_write_u16_array(buffer *buf, const uint16_t *values, int count)
+{
+    int items = items_that_fit(buf, count, 2);
+    uint8_t *data = &buf->data[buf->index];
+#if HOST_IS_LITTLE_ENDIAN
+    memcpy(data, values, items * 2);
+#else
+    for (int i = 0; i < items; i++) {
+        data[2 * i] = values[i] & 0xff;
+        data[2 * i + 1] = (values[i] >> 8) & 0xff;
+    }
+#endif
+    buf->index += items * 2;
+}
+
+void buffer_write_u32_array(buffer *buf, const uint32_t *values, int count)
+{
+    int items = items_that_fit(buf, count, 4);
+    uint8_t *data = &buf->data[buf->index];
+#if HOST_IS_LITTLE_ENDIAN
+    memcpy(data, values, items * 4);
+#else
+    for (int i = 0; i < items; i++) {
+        data[4 * i] = values[i] & 0xff;
+        data[4 * i + 1] = (values[i] >> 8) & 0xff;
+        data[4 * i + 2] = (values[i] >> 16) & 0xff;
+        data[4 * i + 3] = (values[i] >> 24) & 0xff;
+    }
+#endif
+    buf->index += items * 4;
+}
+
 void buffer_write_i8(buffer *buf, int8_t value)
 {
     if (check_size(buf, 1)) {
@@ -88,6 +136,37 @@ void buffer_write_raw(buffer *buf, const void *value, int size)
     }
 }
 
+void buffer_read_u16_array(buffer *buf, uint16_t *values, int count)
+{
+    int items = items_that_fit(buf, count, 2);
+    const uint8_t *data = &buf->data[buf->index];
+#if HOST_IS_LITTLE_ENDIAN
+    memcpy(values, data, items * 2);
+#else
+    for (int i = 0; i < items; i++) {
+        values[i] = (uint16_t) (data[2 * i] | (data[2 * i + 1] << 8));
+    }
+#endif
+    memset(&values[items], 0, (count - items) * 2);
+    buf->index += items * 2;
+}
+
+void buffer_read_u32_array(buffer *buf, uint32_t *values, int count)
+{
+    int items = items_that_fit(buf, count, 4);
+    const uint8_t *data = &buf->data[buf->index];
+#if HOST_IS_LITTLE_ENDIAN
+    memcpy(values, data, items * 4);
+#else
+    for (int i = 0; i < items; i++) {
+        values[i] = (uint32_t) (data[4 * i] | (data[4 * i + 1] << 8) |
+            (data[4 * i + 2] << 16) | ((uint32_t) data[4 * i + 3] << 24));
+    }
+#endif
+    memset(&values[items], 0, (count - items) * 4);
+    buf->index += items * 4;
+}
+
 uint8_t buffer_read_u8(buffer *buf)
 {
     if (check_size(buf, 1)) {
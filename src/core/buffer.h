@@ -60,6 +60,22 @@ void buffer_write_u16(buffer *buffer, uint16_t value);
  */
 void buffer_write_u32(buffer *buffer, uint32_t value);
 
+/**
+ * Writes an array of unsigned 16-bit integers in one go
+ * @param buffer Buffer
+ * @param values Values to write
+ * @param count Number of values
+ */
+void buffer_write_u16_array(buffer *buffer, const uint16_t *values, int count);
+
+/**
+ * Writes an array of unsigned 32-bit integers in one go
+ * @param buffer Buffer
+ * @param values Values to write
+ * @param count Number of values
+ */
+void buffer_write_u32_array(buffer *buffer, const uint32_t *values, int count);
+
 /**
  * Writes a signed 8-bit integer
  * @param buffer Buffer
@@ -89,6 +105,22 @@ void buffer_write_i32(buffer *buffer, int32_t value);
  */
 void buffer_write_raw(buffer *buffer, const void *value, int size);
 
+/**
+ * Reads an array of unsigned 16-bit integers in one go. Values past the end of the buffer are set to 0
+ * @param buffer Buffer
+ * @param values Array to read into
+ * @param count Number of values
+ */
+void buffer_read_u16_array(buffer *buffer, uint16_t *values, int count);
+
+/**
+ * Reads an array of unsigned 32-bit integers in one go. Values past the end of the buffer are set to 0
+ * @param buffer Buffer
+ * @param values Array to read into
+ * @param count Number of values
+ */
+void buffer_read_u32_array(buffer *buffer, uint32_t *values, int count);
+
 /**
  * Reads an unsigned 8-bit integer
  * @param buffer Buffer
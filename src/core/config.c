@@ -62,6 +62,8 @@ static const char *ini_keys[] = {
     "gameplay_change_disable_infinite_wolves_spawning",
     "gameplay_change_romers_dont_skip_corners",
     "gameplay_change_yearly_autosave",
+    "gameplay_turbo",
+    "gameplay_turbo_frame_millis",
 };
 
 static const char *ini_string_keys[] = {
@@ -83,7 +85,8 @@ static int default_values[CONFIG_MAX_ENTRIES] = {
     [CONFIG_UI_HIGHLIGHT_LEGIONS] = 1,
     [CONFIG_SCREEN_DISPLAY_SCALE] = 100,
     [CONFIG_SCREEN_CURSOR_SCALE] = 100,
-    [CONFIG_GP_CH_MAX_GRAND_TEMPLES] = 2
+    [CONFIG_GP_CH_MAX_GRAND_TEMPLES] = 2,
+    [CONFIG_GP_TURBO_FRAME_MILLIS] = 100
 };
 
 static const char default_string_values[CONFIG_STRING_MAX_ENTRIES][CONFIG_STRING_VALUE_MAX];
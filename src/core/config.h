@@ -54,6 +54,8 @@ typedef enum {
     CONFIG_GP_CH_DISABLE_INFINITE_WOLVES_SPAWNING,
     CONFIG_GP_CH_ROAMERS_DONT_SKIP_CORNERS,
     CONFIG_GP_CH_YEARLY_AUTOSAVE,
+    CONFIG_GP_TURBO,
+    CONFIG_GP_TURBO_FRAME_MILLIS,
     CONFIG_MAX_ENTRIES
 } config_key;
 
@@ -21,6 +21,11 @@ int file_close(FILE *stream)
     return platform_file_manager_close_file(stream);
 }
 
+int file_get_stamp(FILE *stream, int *size, int64_t *modified)
+{
+    return platform_file_manager_get_file_stamp(stream, size, modified);
+}
+
 int file_has_extension(const char *filename, const char *extension)
 {
     if (!extension || !*extension) {
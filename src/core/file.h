@@ -41,6 +41,15 @@ FILE *file_open_asset(const char *asset, const char *mode);
  */
 int file_close(FILE *stream);
 
+/**
+ * Gets the size and last modification time of an opened file, to detect whether it has changed
+ * @param stream File
+ * @param size Out: file size in bytes
+ * @param modified Out: last modification time
+ * @return 1 if the information is available, 0 otherwise
+ */
+int file_get_stamp(FILE *stream, int *size, int64_t *modified);
+
 /**
  * Checks whether the file has the given extension
  * @param filename Filename to check
@@ -1,9 +1,6 @@
 #include "core/random.h"
 
 #include <string.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <time.h>
 
 #define MAX_RANDOM 100
 
@@ -18,11 +15,23 @@ static struct {
     int32_t pool[MAX_RANDOM];
 } data;
 
+// Not saved: it is seeded from the saved state instead, so that a game continued from a save is repeatable
+static uint32_t unsaved_state;
+
+static void seed_unsaved_state(void)
+{
+    unsaved_state = (data.iv1 * 2654435761u) ^ data.iv2;
+    if (!unsaved_state) {
+        unsaved_state = 1;
+    }
+}
+
 void random_init(void)
 {
     memset(&data, 0, sizeof(data));
     data.iv1 = 0x54657687;
     data.iv2 = 0x72641663;
+    seed_unsaved_state();
 }
 
 void random_generate_next(void)
@@ -87,6 +96,7 @@ void random_load_state(buffer *buf)
 {
     data.iv1 = buffer_read_u32(buf);
     data.iv2 = buffer_read_u32(buf);
+    seed_unsaved_state();
 }
 
 void random_save_state(buffer *buf)
@@ -95,8 +105,11 @@ void random_save_state(buffer *buf)
     buffer_write_u32(buf, data.iv2);
 }
 
-int random_from_stdlib(void) {
-    time_t t;
-    srand((unsigned)time(&t));
-    return rand();
+int random_from_stdlib(void)
+{
+    // xorshift32
+    unsaved_state ^= unsaved_state << 13;
+    unsaved_state ^= unsaved_state >> 17;
+    unsaved_state ^= unsaved_state << 5;
+    return unsaved_state & 0x7fffffff;
 }
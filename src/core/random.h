@@ -68,5 +68,12 @@ void random_save_state(buffer *buf);
  */
 void random_load_state(buffer *buf);
 
+/**
+ * Gets a random number without changing the random state of the game.
+ * The numbers depend only on the random state of the game when it was started or loaded,
+ * so running the same saved game gives the same numbers.
+ * @return Random non-negative integer
+ */
 int random_from_stdlib(void);
+
 #endif // CORE_RANDOM_H
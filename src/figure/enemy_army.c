@@ -119,6 +119,7 @@ void enemy_army_calculate_roman_influence(void)
             map_soldier_strength_add(m->x_home, m->y_home, 2, 1);
         }
     }
+    map_soldier_strength_apply();
 }
 
 int enemy_army_is_stronger_than_legions(void)
@@ -177,6 +177,7 @@ void figure_delete(figure *f)
     memset(f, 0, sizeof(figure));
     f->id = figure_id;
 
+    array_item_released(data.figures, figure_id);
     array_trim(data.figures);
 }
 
@@ -216,6 +217,7 @@ void figure_init_scenario(void)
         !array_next(data.figures)) { // Ignore first figure
         log_error("Unable to create figures array. The game will now crash.", 0, 0);
     }
+    array_track_used_items(data.figures);
     data.created_sequence = 0;
 }
 
@@ -462,7 +464,7 @@ void figure_save_state(buffer *list, buffer *seq)
     buffer_write_i32(seq, data.created_sequence);
 
     int buf_size = 4 + data.figures.size * FIGURE_CURRENT_BUFFER_SIZE;
-    uint8_t *buf_data = malloc(buf_size);
+    uint8_t *buf_data = calloc(1, buf_size);
     buffer_init(list, buf_data, buf_size);
     buffer_write_i32(list, FIGURE_CURRENT_BUFFER_SIZE);
 
@@ -491,6 +493,7 @@ void figure_load_state(buffer *list, buffer *seq, int includes_figure_size)
         !array_expand(data.figures, figures_to_load)) {
         log_error("Unable to create figures array. The game will now crash.", 0, 0);
     }
+    array_track_used_items(data.figures);
 
     int highest_id_in_use = 0;
 
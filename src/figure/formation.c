@@ -46,6 +46,7 @@ void formations_clear(void)
         !array_next(formations)) { // Ignore first formation
         log_error("Unable to create the formations array. The game will likely crash.", 0, 0);
     }
+    array_track_used_items(formations);
     data.id_last_in_use = 0;
     data.id_last_legion = 0;
     data.num_legions = 0;
@@ -55,6 +56,7 @@ void formations_clear(void)
 void formation_clear(int formation_id)
 {
     array_item(formations, formation_id)->in_use = 0;
+    array_item_released(formations, formation_id);
     array_trim(formations);
 }
 
@@ -696,7 +698,7 @@ void formation_update_all(int second_time)
 void formations_save_state(buffer *buf, buffer *totals)
 {
     int buf_size = 4 + formations.size * CURRENT_BUFFER_SIZE_PER_FORMATION;
-    uint8_t *buf_data = malloc(buf_size);
+    uint8_t *buf_data = calloc(1, buf_size);
     buffer_init(buf, buf_data, buf_size);
     buffer_write_i32(buf, CURRENT_BUFFER_SIZE_PER_FORMATION);
 
@@ -788,6 +790,7 @@ void formations_load_state(buffer *buf, buffer *totals, int includes_buffer_size
         !array_expand(formations, formations_to_load)) {
         log_error("Unable to create the formations array. The game will likely crash.", 0, 0);
     }
+    array_track_used_items(formations);
 
     // Reduce number of used formations. Improves performance
     int highest_id_in_use = 0;
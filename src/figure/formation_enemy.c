@@ -177,22 +177,10 @@ static building *get_best_building(const int *priority_order, int max)
 
 static building *get_best_and_closest_building(int x, int y, const int *priority_order, int max)
 {
-    int min_distance = INFINITE;
     for (int i = 0; i < max; i++) {
-        building_type type = priority_order[i];
-        building *best_building = 0;
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE) {
-                continue;
-            }
-            int distance = calc_maximum_distance(x, y, b->x, b->y);
-            if (distance < min_distance) {
-                best_building = b;
-                min_distance = distance;
-            }
-        }
-        if (best_building) {
-            return best_building;
+        building *b = building_find_closest_of_type(priority_order[i], x, y, INFINITE);
+        if (b) {
+            return b;
         }
     }
     return 0;
@@ -211,25 +199,11 @@ int formation_rioter_get_target_building(int *x_tile, int *y_tile)
 
 int formation_rioter_get_target_building_for_robbery(int x, int y, int *x_tile, int *y_tile)
 {
-    building *best_building = 0;
-    int closest = INFINITE;
-
-    static const building_type building_targets[] = { BUILDING_SENATE, BUILDING_FORUM };
-    for (int i = 0; i < 2; i++) {
-        building_type type = building_targets[i];
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE) {
-                continue;
-            }
-            int distance = calc_maximum_distance(x, y, b->x, b->y);
-            if (distance >= 150) {
-                continue;
-            }
-            if (distance < closest) {
-                closest = distance;
-                best_building = b;
-            }
-        }
+    building *best_building = building_find_closest_of_type(BUILDING_SENATE, x, y, 150);
+    int max_distance = best_building ? calc_maximum_distance(x, y, best_building->x, best_building->y) : 150;
+    building *forum = building_find_closest_of_type(BUILDING_FORUM, x, y, max_distance);
+    if (forum) {
+        best_building = forum;
     }
     if (!best_building) {
         return 0;
@@ -16,6 +16,7 @@
 #include "map/property.h"
 #include "map/random.h"
 #include "map/road_access.h"
+#include "map/road_graph.h"
 #include "map/routing_terrain.h"
 #include "map/terrain.h"
 
@@ -512,10 +513,24 @@ void figure_movement_roam_ticks(figure *f, int num_ticks)
             if (figure_service_provide_coverage(f)) {
                 return;
             }
+            int segment_direction = -1;
+            if (f->roam_ticks_until_next_turn != -1 && (f->direction & 1) == 0) {
+                segment_direction = map_road_graph_segment_exit(f->grid_offset, came_from_direction);
+            }
+            if (segment_direction >= 0) {
+                // on a straight or bending road there is only one way to go
+                f->direction = segment_direction;
+                f->routing_path_current_tile++;
+                f->previous_tile_direction = f->direction;
+                f->progress_on_tile = 0;
+                move_to_next_tile(f);
+                advance_tick(f);
+                continue;
+            }
             int road_tiles[8];
             int permission = get_permission_for_figure_type(f);
-            int adjacent_road_tiles = map_get_adjacent_road_tiles_for_roaming(f->grid_offset, road_tiles, permission);
-            if (adjacent_road_tiles == 3 && map_get_diagonal_road_tiles_for_roaming(f->grid_offset, road_tiles) >= 5) {
+            int adjacent_road_tiles = map_road_graph_adjacent_road_tiles(f->grid_offset, road_tiles, permission);
+            if (adjacent_road_tiles == 3 && map_road_graph_diagonal_road_tiles(f->grid_offset, road_tiles) >= 5) {
                 // go in the straight direction of a double-wide road
                 adjacent_road_tiles = 2;
                 if (came_from_direction == DIR_0_TOP || came_from_direction == DIR_4_BOTTOM) {
@@ -532,7 +547,7 @@ void figure_movement_roam_ticks(figure *f, int num_ticks)
                     }
                 }
             }
-            if (adjacent_road_tiles == 4 && map_get_diagonal_road_tiles_for_roaming(f->grid_offset, road_tiles) >= 8) {
+            if (adjacent_road_tiles == 4 && map_road_graph_diagonal_road_tiles(f->grid_offset, road_tiles) >= 8) {
                 // go straight on when all surrounding tiles are road
                 adjacent_road_tiles = 2;
                 if (came_from_direction == DIR_0_TOP || came_from_direction == DIR_4_BOTTOM) {
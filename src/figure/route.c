@@ -1,21 +1,117 @@
 #include "route.h"
 
 #include "core/array.h"
+#include "core/calc.h"
 #include "core/log.h"
 #include "map/routing.h"
 #include "map/routing_path.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #define ARRAY_SIZE_STEP 600
 #define MAX_PATH_LENGTH 500
+#define BITS_PER_DIRECTION 3
+#define DIRECTIONS_SIZE_STEP 16384
 
 typedef struct {
     int id;
     int figure_id;
-    uint8_t directions[MAX_PATH_LENGTH];
+    int offset;
+    int length;
 } figure_path_data;
 
 static array(figure_path_data) paths;
 
+// Directions of all paths, packed at three bits per direction
+static struct {
+    uint8_t *data;
+    int size;
+    int capacity;
+    int in_use;
+} directions;
+
+static int packed_size(int length)
+{
+    // one extra byte so that a direction can always be read as two bytes
+    return (length * BITS_PER_DIRECTION + 7) / 8 + 1;
+}
+
+static void release_path(figure_path_data *path)
+{
+    path->figure_id = 0;
+    directions.in_use -= packed_size(path->length);
+    path->length = 0;
+}
+
+static void compact_directions(uint8_t *data)
+{
+    int size = 0;
+    figure_path_data *path;
+    array_foreach(paths, path)
+    {
+        if (path->figure_id) {
+            int path_size = packed_size(path->length);
+            memcpy(&data[size], &directions.data[path->offset], path_size);
+            path->offset = size;
+            size += path_size;
+        }
+    }
+    free(directions.data);
+    directions.data = data;
+    directions.size = size;
+}
+
+static int reserve_directions(int size)
+{
+    if (directions.size + size <= directions.capacity) {
+        return 1;
+    }
+    int capacity = directions.capacity;
+    if (directions.in_use + size > capacity / 2) {
+        capacity = capacity ? capacity * 2 : DIRECTIONS_SIZE_STEP;
+        while (directions.in_use + size > capacity / 2) {
+            capacity *= 2;
+        }
+    }
+    uint8_t *data = malloc(capacity);
+    if (!data) {
+        return 0;
+    }
+    compact_directions(data);
+    directions.capacity = capacity;
+    return 1;
+}
+
+static int store_directions(figure_path_data *path, const uint8_t *path_directions, int length)
+{
+    int size = packed_size(length);
+    if (!reserve_directions(size)) {
+        log_error("Unable to store the figure path. The figure will not move.", 0, 0);
+        return 0;
+    }
+    uint8_t *data = &directions.data[directions.size];
+    memset(data, 0, size);
+    for (int i = 0; i < length; i++) {
+        int bit = i * BITS_PER_DIRECTION;
+        int value = (path_directions[i] & 7) << (bit & 7);
+        data[bit >> 3] |= value & 0xff;
+        data[(bit >> 3) + 1] |= value >> 8;
+    }
+    path->offset = directions.size;
+    path->length = length;
+    directions.size += size;
+    directions.in_use += size;
+    return 1;
+}
+
+static int get_direction(const figure_path_data *path, int index)
+{
+    int bit = index * BITS_PER_DIRECTION;
+    const uint8_t *data = &directions.data[path->offset + (bit >> 3)];
+    return ((data[0] | data[1] << 8) >> (bit & 7)) & 7;
+}
+
 static void create_new_path(figure_path_data *path, int position)
 {
     path->id = position;
@@ -30,6 +126,8 @@ void figure_route_clear_all(void)
 {
     paths.size = 0;
     array_trim(paths);
+    directions.size = 0;
+    directions.in_use = 0;
 }
 
 void figure_route_clean(void)
@@ -41,7 +139,7 @@ void figure_route_clean(void)
         if (figure_id > 0 && figure_id < figure_count()) {
             const figure *f = figure_get(figure_id);
             if (f->state != FIGURE_STATE_ALIVE || f->routing_path_id != i) {
-                path->figure_id = 0;
+                release_path(path);
             }
         }
     }
@@ -66,15 +164,16 @@ void figure_route_add(figure *f)
     if (!path) {
         return;
     }
+    uint8_t path_directions[MAX_PATH_LENGTH];
     int path_length;
     if (f->is_boat) {
         if (f->is_boat == 2) { // flotsam
             map_routing_calculate_distances_water_flotsam(f->x, f->y);
-            path_length = map_routing_get_path_on_water(path->directions,
+            path_length = map_routing_get_path_on_water(path_directions,
                 f->destination_x, f->destination_y, 1);
         } else {
             map_routing_calculate_distances_water_boat(f->x, f->y);
-            path_length = map_routing_get_path_on_water(path->directions,
+            path_length = map_routing_get_path_on_water(path_directions,
                 f->destination_x, f->destination_y, 0);
         }
     } else {
@@ -120,21 +219,21 @@ void figure_route_add(figure *f)
         }
         if (can_travel) {
             if (f->terrain_usage == TERRAIN_USAGE_WALLS) {
-                path_length = map_routing_get_path(path->directions, f->x, f->y,
+                path_length = map_routing_get_path(path_directions, f->x, f->y,
                     f->destination_x, f->destination_y, 4);
                 if (path_length <= 0) {
-                    path_length = map_routing_get_path(path->directions, f->x, f->y,
+                    path_length = map_routing_get_path(path_directions, f->x, f->y,
                         f->destination_x, f->destination_y, direction_limit);
                 }
             } else {
-                path_length = map_routing_get_path(path->directions, f->x, f->y,
+                path_length = map_routing_get_path(path_directions, f->x, f->y,
                     f->destination_x, f->destination_y, direction_limit);
             }
         } else { // cannot travel
             path_length = 0;
         }
     }
-    if (path_length) {
+    if (path_length && store_directions(path, path_directions, path_length)) {
         path->figure_id = f->id;
         f->routing_path_id = path->id;
         f->routing_path_length = path_length;
@@ -145,7 +244,7 @@ void figure_route_remove(figure *f)
 {
     if (f->routing_path_id > 0) {
         if (f->routing_path_id < paths.size && array_item(paths, f->routing_path_id)->figure_id == f->id) {
-            array_item(paths, f->routing_path_id)->figure_id = 0;
+            release_path(array_item(paths, f->routing_path_id));
         }
         f->routing_path_id = 0;
     }
@@ -154,30 +253,55 @@ void figure_route_remove(figure *f)
 
 int figure_route_get_direction(int path_id, int index)
 {
-    return array_item(paths, path_id)->directions[index];
+    return get_direction(array_item(paths, path_id), index);
 }
 
 void figure_route_save_state(buffer *figures, buffer *buf_paths)
 {
-    int size = paths.size * sizeof(int);
+    int size = paths.size * sizeof(int16_t);
     uint8_t *buf_data = malloc(size);
     buffer_init(figures, buf_data, size);
 
-    size = paths.size * sizeof(uint8_t) * MAX_PATH_LENGTH;
+    size = 0;
+    figure_path_data *path;
+    array_foreach(paths, path)
+    {
+        size += sizeof(int16_t) + (path->figure_id ? packed_size(path->length) - 1 : 0);
+    }
     buf_data = malloc(size);
     buffer_init(buf_paths, buf_data, size);
 
-    figure_path_data *path;
+    // each path is saved as its length followed by its packed directions
     array_foreach(paths, path)
     {
         buffer_write_i16(figures, path->figure_id);
-        buffer_write_raw(buf_paths, path->directions, MAX_PATH_LENGTH);
+        int length = path->figure_id ? path->length : 0;
+        buffer_write_i16(buf_paths, length);
+        if (length) {
+            buffer_write_raw(buf_paths, &directions.data[path->offset], packed_size(length) - 1);
+        }
+    }
+}
+
+static int read_path(buffer *buf_paths, int compact_paths, uint8_t *path_directions)
+{
+    if (!compact_paths) {
+        buffer_read_raw(buf_paths, path_directions, MAX_PATH_LENGTH);
+        return MAX_PATH_LENGTH;
+    }
+    int length = calc_bound(buffer_read_i16(buf_paths), 0, MAX_PATH_LENGTH);
+    uint8_t data[MAX_PATH_LENGTH * BITS_PER_DIRECTION / 8 + 2] = { 0 };
+    buffer_read_raw(buf_paths, data, packed_size(length) - 1);
+    for (int i = 0; i < length; i++) {
+        int bit = i * BITS_PER_DIRECTION;
+        path_directions[i] = ((data[bit >> 3] | data[(bit >> 3) + 1] << 8) >> (bit & 7)) & 7;
     }
+    return length;
 }
 
-void figure_route_load_state(buffer *figures, buffer *buf_paths)
+void figure_route_load_state(buffer *figures, buffer *buf_paths, int compact_paths)
 {
-    int elements_to_load = buf_paths->size / MAX_PATH_LENGTH;
+    int elements_to_load = compact_paths ? figures->size / (int) sizeof(int16_t) : buf_paths->size / MAX_PATH_LENGTH;
 
     if (!array_init(paths, ARRAY_SIZE_STEP, create_new_path, path_is_used) ||
         !array_expand(paths, elements_to_load)) {
@@ -185,13 +309,29 @@ void figure_route_load_state(buffer *figures, buffer *buf_paths)
         return;
     }
 
+    directions.size = 0;
+    directions.in_use = 0;
+
     int highest_id_in_use = 0;
+    uint8_t path_directions[MAX_PATH_LENGTH];
 
     for (int i = 0; i < elements_to_load; i++) {
         figure_path_data *path = array_next(paths);
-        path->figure_id = buffer_read_i16(figures);
-        buffer_read_raw(buf_paths, path->directions, MAX_PATH_LENGTH);
-        if (path->figure_id) {
+        int figure_id = buffer_read_i16(figures);
+        int saved_length = read_path(buf_paths, compact_paths, path_directions);
+        if (!figure_id) {
+            continue;
+        }
+        // only the part of the path that its figure will walk is kept
+        int length = 0;
+        if (i > 0 && figure_id < figure_count()) {
+            const figure *f = figure_get(figure_id);
+            if (f->routing_path_id == i) {
+                length = calc_bound(f->routing_path_length, 0, saved_length);
+            }
+        }
+        if (store_directions(path, path_directions, length)) {
+            path->figure_id = figure_id;
             highest_id_in_use = i;
         }
     }
@@ -14,8 +14,19 @@ void figure_route_remove(figure *f);
 
 int figure_route_get_direction(int path_id, int index);
 
+/**
+ * Saves the routes. Each path is saved as its length followed by its directions, packed at three bits each.
+ * @param figures Buffer for the figure id of each path
+ * @param buf_paths Buffer for the directions of each path
+ */
 void figure_route_save_state(buffer *figures, buffer *buf_paths);
 
-void figure_route_load_state(buffer *figures, buffer *buf_paths);
+/**
+ * Loads the routes
+ * @param figures Buffer with the figure id of each path
+ * @param buf_paths Buffer with the directions of each path
+ * @param compact_paths Whether the paths are packed, instead of using a fixed size of 500 directions each
+ */
+void figure_route_load_state(buffer *figures, buffer *buf_paths, int compact_paths);
 
 #endif // FIGURE_ROUTE_H
@@ -147,9 +147,11 @@ int figure_trade_caravan_can_sell(figure *trader, int building_id, int city_id)
         }
         return 0;
     }
+    int accepting[RESOURCE_MAX];
+    building_warehouse_get_accepted_resources(b, accepting);
     int num_importable = 0;
     for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
-        if (!building_warehouse_is_not_accepting(r, b)) {
+        if (accepting[r]) {
             if (empire_can_import_resource_from_city(city_id, r)) {
                 num_importable++;
             }
@@ -160,14 +162,12 @@ int figure_trade_caravan_can_sell(figure *trader, int building_id, int city_id)
     }
     int can_import = 0;
     int resource = city_trade_current_caravan_import_resource();
-    if (!building_warehouse_is_not_accepting(resource, b) &&
-        empire_can_import_resource_from_city(city_id, resource)) {
+    if (accepting[resource] && empire_can_import_resource_from_city(city_id, resource)) {
         can_import = 1;
     } else {
         for (int i = RESOURCE_MIN; i < RESOURCE_MAX; i++) {
             resource = city_trade_next_caravan_import_resource();
-            if (!building_warehouse_is_not_accepting(resource, b) &&
-                empire_can_import_resource_from_city(city_id, resource)) {
+            if (accepting[resource] && empire_can_import_resource_from_city(city_id, resource)) {
                 can_import = 1;
                 break;
             }
@@ -316,20 +316,25 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
     int can_import = 0;
     int exportable[RESOURCE_MAX];
     int importable[RESOURCE_MAX];
+    int sold_by_city[RESOURCE_MAX];
+    int accepting[RESOURCE_MAX];
+    int trade_units = figure_trade_land_trade_units();
     exportable[RESOURCE_NONE] = 0;
     importable[RESOURCE_NONE] = 0;
+    sold_by_city[RESOURCE_NONE] = 0;
     for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
+        sold_by_city[r] = empire_can_import_resource_from_city(city_id, r);
 
         exportable[r] = empire_can_export_resource_to_city(city_id, r);
-        if (f->trader_amount_bought >= figure_trade_land_trade_units()) {
+        if (f->trader_amount_bought >= trade_units) {
             exportable[r] = 0;
         }
         if (city_id) {
-            importable[r] = empire_can_import_resource_from_city(city_id, r);
+            importable[r] = sold_by_city[r];
         } else { // Don't import goods from native traders
             importable[r] = 0;
         }
-        if (f->loads_sold_or_carrying >= figure_trade_land_trade_units()) {
+        if (f->loads_sold_or_carrying >= trade_units) {
             importable[r] = 0;
         }
         can_import |= importable[r];
@@ -344,8 +349,9 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
         const building_storage *s = building_storage_get(b->storage_id);
         int distance_penalty = 32;
         int num_imports_for_warehouse = 0;
+        building_warehouse_get_accepted_resources(b, accepting);
         for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
-            if (!building_warehouse_is_not_accepting(r, b) && empire_can_import_resource_from_city(city_id, r)) {
+            if (accepting[r] && sold_by_city[r]) {
                 num_imports_for_warehouse++;
             }
         }
@@ -357,12 +363,12 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
             }
             if (can_import && num_imports_for_warehouse && !s->empty_all) {
                 for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
-                    if (!building_warehouse_is_not_accepting(city_trade_next_caravan_import_resource(), b)) {
+                    if (accepting[city_trade_next_caravan_import_resource()]) {
                         break;
                     }
                 }
                 int resource = city_trade_current_caravan_import_resource();
-                if (!building_warehouse_is_not_accepting(resource, b)) {
+                if (accepting[resource]) {
                     if (space->subtype.warehouse_resource_id == RESOURCE_NONE) {
                         distance_penalty -= 16;
                     }
@@ -401,7 +407,7 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
             }
             if (!can_import || s->empty_all || !importable[resource] ||
                 building_granary_is_full(resource, b) || building_granary_is_not_accepting(resource, b) ||
-                !empire_can_import_resource_from_city(city_id, resource)) {
+                !sold_by_city[resource]) {
                 continue;
             }
             if (building_granary_resource_amount(RESOURCE_NONE, b) >= 4 * RESOURCE_GRANARY_ONE_LOAD) {
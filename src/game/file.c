@@ -32,6 +32,7 @@
 #include "game/animation.h"
 #include "game/difficulty.h"
 #include "game/file_io.h"
+#include "game/replay.h"
 #include "game/settings.h"
 #include "game/state.h"
 #include "game/time.h"
@@ -46,6 +47,7 @@
 #include "map/grid.h"
 #include "map/image.h"
 #include "map/image_context.h"
+#include "map/journal.h"
 #include "map/natives.h"
 #include "map/orientation.h"
 #include "map/property.h"
@@ -71,6 +73,7 @@
 #include "scenario/scenario.h"
 #include "sound/city.h"
 #include "sound/music.h"
+#include "widget/city_with_overlay.h"
 
 #include <string.h>
 
@@ -114,6 +117,7 @@ static void clear_scenario_data(void)
     game_time_init(2098);
 
     // clear grids
+    map_journal_clear();
     map_image_clear();
     map_building_clear();
     map_terrain_clear();
@@ -252,6 +256,8 @@ static void check_backward_compatibility(void)
 
 static void initialize_saved_game(void)
 {
+    map_journal_clear();
+
     load_empire_data(scenario_is_custom(), scenario_empire_id());
 
     scenario_map_init();
@@ -273,6 +279,7 @@ static void initialize_saved_game(void)
     building_construction_clear_type();
     game_undo_disable();
     game_state_reset_overlay();
+    city_with_overlay_reset_cache();
 
     city_mission_tutorial_set_fire_message_shown(1);
     city_mission_tutorial_set_disease_message_shown(1);
@@ -354,6 +361,8 @@ static int start_scenario(const uint8_t *scenario_name, const char *scenario_fil
 
     building_menu_update();
     city_message_init_scenario();
+    city_with_overlay_reset_cache();
+    game_replay_start_recording();
     return 1;
 }
 
@@ -396,6 +405,7 @@ int game_file_load_saved_game(const char *filename)
     building_storage_reset_building_ids();
 
     sound_music_update(1);
+    game_replay_start_recording();
     return 1;
 }
 
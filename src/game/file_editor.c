@@ -30,6 +30,7 @@
 #include "map/figure.h"
 #include "map/image.h"
 #include "map/image_context.h"
+#include "map/journal.h"
 #include "map/natives.h"
 #include "map/property.h"
 #include "map/random.h"
@@ -73,6 +74,7 @@ void game_file_editor_clear_data(void)
 
 static void clear_map_data(void)
 {
+    map_journal_clear();
     map_image_clear();
     map_building_clear();
     map_terrain_clear();
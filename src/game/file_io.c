@@ -24,6 +24,7 @@
 #include "figure/name.h"
 #include "figure/route.h"
 #include "figure/trader.h"
+#include "game/savegame_index.h"
 #include "game/time.h"
 #include "game/tutorial.h"
 #include "map/aqueduct.h"
@@ -32,6 +33,7 @@
 #include "map/desirability.h"
 #include "map/elevation.h"
 #include "map/figure.h"
+#include "map/grid.h"
 #include "map/image.h"
 #include "map/property.h"
 #include "map/random.h"
@@ -55,10 +57,11 @@
 
 #define COMPRESS_BUFFER_SIZE 3000000
 #define UNCOMPRESSED 0x80000000
+#define SAVEGAME_INFO_INDEX_HEADER_SIZE 48
 
 #define PIECE_SIZE_DYNAMIC 0
 
-static const int SAVE_GAME_CURRENT_VERSION = 0x88;
+static const int SAVE_GAME_CURRENT_VERSION = 0x89;
 
 static const int SAVE_GAME_LAST_ORIGINAL_LIMITS_VERSION = 0x66;
 static const int SAVE_GAME_LAST_SMALLER_IMAGE_ID_VERSION = 0x76;
@@ -73,6 +76,7 @@ static const int SAVE_GAME_INCREASE_GRANARY_CAPACITY = 0x85;
 // static const int SAVE_GAME_ROADBLOCK_DATA_MOVED_FROM_SUBTYPE = 0x86; This define is unneeded for now
 static const int SAVE_GAME_LAST_ORIGINAL_TERRAIN_DATA_SIZE_VERSION = 0x86;
 static const int SAVE_GAME_LAST_CARAVANSERAI_WRONG_OFFSET = 0x87;
+static const int SAVE_GAME_LAST_FIXED_SIZE_ROUTE_PATHS_VERSION = 0x88;
 
 static char compress_buffer[COMPRESS_BUFFER_SIZE];
 
@@ -80,6 +84,9 @@ typedef struct {
     buffer buf;
     int compressed;
     int dynamic;
+    int arena_offset;
+    uint8_t *dynamic_data; // kept between loads, reallocated only when a bigger piece is read
+    int dynamic_capacity;
 } file_piece;
 
 typedef struct {
@@ -221,6 +228,11 @@ static struct {
     int num_pieces;
     file_piece pieces[100];
     savegame_state state;
+    struct {
+        uint8_t *data;
+        int size;
+        int used;
+    } arena;
 } savegame_data;
 
 static struct {
@@ -229,7 +241,10 @@ static struct {
     int city_width;
     int city_height;
     int caravanserai_id;
+    int grid_start;
+    int grid_border_size;
     scenario_climate climate;
+    uint8_t tile_types[GRID_SIZE * GRID_SIZE];
 } minimap_data;
 
 static void init_file_piece(file_piece *piece, int size, int compressed)
@@ -252,20 +267,63 @@ static buffer *create_scenario_piece(int size)
     return &piece->buf;
 }
 
-static buffer *create_savegame_piece(int size, int compressed)
+static file_piece *add_savegame_piece(int size, int compressed)
 {
     file_piece *piece = &savegame_data.pieces[savegame_data.num_pieces++];
-    init_file_piece(piece, size, compressed);
-    return &piece->buf;
+    piece->compressed = compressed;
+    piece->dynamic = size == PIECE_SIZE_DYNAMIC;
+    // fixed size pieces get their memory from the arena once all pieces are known
+    piece->arena_offset = savegame_data.arena.used;
+    savegame_data.arena.used += size;
+    buffer_init(&piece->buf, 0, size);
+    return piece;
+}
+
+static buffer *create_savegame_piece(int size, int compressed)
+{
+    return &add_savegame_piece(size, compressed)->buf;
+}
+
+static int allocate_savegame_pieces(void)
+{
+    if (savegame_data.arena.used > savegame_data.arena.size) {
+        free(savegame_data.arena.data);
+        savegame_data.arena.data = malloc(savegame_data.arena.used);
+        if (!savegame_data.arena.data) {
+            savegame_data.arena.size = 0;
+            savegame_data.num_pieces = 0;
+            savegame_data.arena.used = 0;
+            log_error("Unable to allocate memory for the savegame", 0, 0);
+            return 0;
+        }
+        savegame_data.arena.size = savegame_data.arena.used;
+    }
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        file_piece *piece = &savegame_data.pieces[i];
+        if (!piece->dynamic) {
+            buffer_init(&piece->buf, savegame_data.arena.data + piece->arena_offset, piece->buf.size);
+        }
+    }
+    return 1;
+}
+
+static void clear_savegame_piece_contents(void)
+{
+    memset(savegame_data.arena.data, 0, savegame_data.arena.used);
 }
 
 static void clear_savegame_pieces(void)
 {
     for (int i = 0; i < savegame_data.num_pieces; i++) {
-        buffer_reset(&savegame_data.pieces[i].buf);
-        free(savegame_data.pieces[i].buf.data);
+        file_piece *piece = &savegame_data.pieces[i];
+        // dynamic pieces are allocated by the save functions when saving
+        if (piece->dynamic && piece->buf.data != piece->dynamic_data) {
+            free(piece->buf.data);
+        }
+        buffer_reset(&piece->buf);
     }
     savegame_data.num_pieces = 0;
+    savegame_data.arena.used = 0;
 }
 
 static int reset_scenario_pieces(void)
@@ -339,7 +397,7 @@ static void get_version_data(savegame_version_data *version_data, int version)
     version_data->has_monument_deliveries = version > SAVE_GAME_LAST_NO_DELIVERIES_VERSION;
 }
 
-static void init_savegame_data(int version)
+static int init_savegame_data(int version)
 {
     clear_savegame_pieces();
 
@@ -435,6 +493,7 @@ static void init_savegame_data(int version)
     if (version_data.has_monument_deliveries) {
         state->deliveries = create_savegame_piece(version_data.piece_sizes.monument_deliveries, 0);
     }
+    return allocate_savegame_pieces();
 }
 
 static void scenario_load_from_state(scenario_state *file)
@@ -492,7 +551,8 @@ static void savegame_load_from_state(savegame_state *state, int version)
     map_desirability_load_state(state->desirability_grid);
     map_elevation_load_state(state->elevation_grid);
     figure_load_state(state->figures, state->figure_sequence, version > SAVE_GAME_LAST_STATIC_VERSION);
-    figure_route_load_state(state->route_figures, state->route_paths);
+    figure_route_load_state(state->route_figures, state->route_paths,
+        version > SAVE_GAME_LAST_FIXED_SIZE_ROUTE_PATHS_VERSION);
     formations_load_state(state->formations, state->formation_totals, version > SAVE_GAME_LAST_STATIC_VERSION);
 
     city_data_load_state(state->city_data,
@@ -764,6 +824,7 @@ int game_file_io_read_scenario_info(const char *filename, scenario_info *info)
     minimap_data.functions.offset.random = scenario_random_at;
     minimap_data.functions.offset.terrain = scenario_terrain_at;
     minimap_data.functions.offset.tile_size = scenario_tile_size_at;
+    minimap_data.functions.offset.tile_type = 0;
 
     city_view_set_custom_lookup(grid_start, minimap_data.city_width, minimap_data.city_height, grid_border_size);
     widget_minimap_update(&minimap_data.functions);
@@ -823,10 +884,15 @@ static int read_compressed_chunk(FILE *fp, void *buffer, int bytes_to_read)
             return 0;
         }
     } else {
+        int bytes_read = bytes_to_read;
         if (fread(compress_buffer, 1, input_size, fp) != input_size
-            || !zip_decompress(compress_buffer, input_size, buffer, &bytes_to_read)) {
+            || !zip_decompress(compress_buffer, input_size, buffer, &bytes_read)) {
             return 0;
         }
+        // piece buffers are not cleared beforehand
+        if (bytes_read < bytes_to_read) {
+            memset((uint8_t *) buffer + bytes_read, 0, bytes_to_read - bytes_read);
+        }
     }
     return 1;
 }
@@ -855,9 +921,16 @@ static int prepare_dynamic_piece(FILE *fp, file_piece *piece)
         if (!size) {
             return 0;
         }
-        uint8_t *data = malloc(size);
-        memset(data, 0, size);
-        buffer_init(&piece->buf, data, size);
+        if (size > piece->dynamic_capacity) {
+            free(piece->dynamic_data);
+            piece->dynamic_data = malloc(size);
+            if (!piece->dynamic_data) {
+                piece->dynamic_capacity = 0;
+                return 0;
+            }
+            piece->dynamic_capacity = size;
+        }
+        buffer_init(&piece->buf, piece->dynamic_data, size);
     }
     return 1;
 }
@@ -870,6 +943,10 @@ static int savegame_read_from_file(FILE *fp)
         if (!prepare_dynamic_piece(fp, piece)) {
             continue;
         }
+        if (i == savegame_data.num_pieces - 1) {
+            // only the last piece may be partially read, so it is the only one that needs clearing
+            memset(piece->buf.data, 0, piece->buf.size);
+        }
         if (piece->compressed) {
             result = read_compressed_chunk(fp, piece->buf.data, piece->buf.size);
         } else {
@@ -935,8 +1012,7 @@ int game_file_io_read_saved_game(const char *filename, int offset)
             return -1;
         }
         log_info("Savegame version", 0, version);
-        init_savegame_data(version);
-        result = savegame_read_from_file(fp);
+        result = init_savegame_data(version) && savegame_read_from_file(fp);
     }
     file_close(fp);
     if (!result) {
@@ -965,12 +1041,6 @@ static int skip_piece(FILE *fp, int size, int compressed)
     return fseek(fp, input_size, SEEK_CUR) == 0;
 }
 
-static void free_file_piece(file_piece *piece)
-{
-    buffer_reset(&piece->buf);
-    free(piece->buf.data);
-}
-
 static int savegame_terrain_at(int grid_offset)
 {
     if (minimap_data.version <= SAVE_GAME_LAST_ORIGINAL_TERRAIN_DATA_SIZE_VERSION) {
@@ -1012,6 +1082,26 @@ static building *savegame_building(int id)
     return &b;
 }
 
+static int savegame_tile_type_at(int grid_offset)
+{
+    return minimap_data.tile_types[grid_offset];
+}
+
+static void update_savegame_minimap(void)
+{
+    memset(&minimap_data.functions, 0, sizeof(minimap_data.functions));
+    minimap_data.functions.climate = get_climate;
+    minimap_data.functions.map.width = map_width;
+    minimap_data.functions.map.height = map_height;
+    minimap_data.functions.viewport = set_viewport;
+    minimap_data.functions.offset.tile_type = savegame_tile_type_at;
+
+    city_view_set_custom_lookup(minimap_data.grid_start, minimap_data.city_width, minimap_data.city_height,
+        minimap_data.grid_border_size);
+    widget_minimap_update(&minimap_data.functions);
+    city_view_restore_lookup();
+}
+
 static int savegame_read_file_info(FILE *fp, saved_game_info *info, int version)
 {
     clear_savegame_pieces();
@@ -1019,27 +1109,27 @@ static int savegame_read_file_info(FILE *fp, saved_game_info *info, int version)
     savegame_version_data version_data;
     get_version_data(&version_data, version);
 
-    file_piece city_data, game_time, terrain_grid, random_grid, scenario;
-    file_piece bitfields_grid, edge_grid, building_grid, buildings;
-
     savegame_state *state = &savegame_data.state;
 
-    init_file_piece(&city_data, 36136, 0);
-    init_file_piece(&game_time, 20, 0);
-    init_file_piece(&terrain_grid, version_data.piece_sizes.terrain_grid, 0);
-    init_file_piece(&random_grid, 26244, 0);
-    init_file_piece(&edge_grid, 26244, 0);
-    init_file_piece(&bitfields_grid, 26244, 0);
-    init_file_piece(&scenario, 1720, 0);
-    init_file_piece(&building_grid, 52488, 0);
-    init_file_piece(&buildings, version_data.piece_sizes.buildings, 0);
-
-    state->terrain_grid = &terrain_grid.buf;
-    state->random_grid = &random_grid.buf;
-    state->edge_grid = &edge_grid.buf;
-    state->bitfields_grid = &bitfields_grid.buf;
-    state->building_grid = &building_grid.buf;
-    state->buildings = &buildings.buf;
+    file_piece *city_data = add_savegame_piece(36136, 0);
+    file_piece *game_time = add_savegame_piece(20, 0);
+    file_piece *terrain_grid = add_savegame_piece(version_data.piece_sizes.terrain_grid, 0);
+    file_piece *random_grid = add_savegame_piece(26244, 0);
+    file_piece *edge_grid = add_savegame_piece(26244, 0);
+    file_piece *bitfields_grid = add_savegame_piece(26244, 0);
+    file_piece *scenario = add_savegame_piece(1720, 0);
+    file_piece *building_grid = add_savegame_piece(52488, 0);
+    file_piece *buildings = add_savegame_piece(version_data.piece_sizes.buildings, 0);
+    if (!allocate_savegame_pieces()) {
+        return 0;
+    }
+
+    state->terrain_grid = &terrain_grid->buf;
+    state->random_grid = &random_grid->buf;
+    state->edge_grid = &edge_grid->buf;
+    state->bitfields_grid = &bitfields_grid->buf;
+    state->building_grid = &building_grid->buf;
+    state->buildings = &buildings->buf;
 
     info->mission = read_int32(fp);
 
@@ -1048,28 +1138,28 @@ static int savegame_read_file_info(FILE *fp, saved_game_info *info, int version)
         skip_piece(fp, version_data.piece_sizes.image_grid, 1);
     }
 
-    if (!read_compressed_chunk(fp, edge_grid.buf.data, edge_grid.buf.size)) {
+    if (!read_compressed_chunk(fp, edge_grid->buf.data, edge_grid->buf.size)) {
         return 0;
     }
 
-    if (!read_compressed_chunk(fp, building_grid.buf.data, building_grid.buf.size)) {
+    if (!read_compressed_chunk(fp, building_grid->buf.data, building_grid->buf.size)) {
         return 0;
     }
 
-    if (!read_compressed_chunk(fp, terrain_grid.buf.data, terrain_grid.buf.size)) {
+    if (!read_compressed_chunk(fp, terrain_grid->buf.data, terrain_grid->buf.size)) {
         return 0;
     }
 
     skip_piece(fp, 26244, 1);
     skip_piece(fp, 52488, 1);
 
-    if (!read_compressed_chunk(fp, bitfields_grid.buf.data, bitfields_grid.buf.size)) {
+    if (!read_compressed_chunk(fp, bitfields_grid->buf.data, bitfields_grid->buf.size)) {
         return 0;
     }
 
     skip_piece(fp, 26244, 1);
 
-    if (fread(random_grid.buf.data, 1, random_grid.buf.size, fp) != random_grid.buf.size) {
+    if (fread(random_grid->buf.data, 1, random_grid->buf.size, fp) != random_grid->buf.size) {
         return 0;
     }
 
@@ -1084,7 +1174,7 @@ static int savegame_read_file_info(FILE *fp, saved_game_info *info, int version)
     skip_piece(fp, version_data.piece_sizes.formations, 1);
     skip_piece(fp, 12, 0);
 
-    if (!read_compressed_chunk(fp, city_data.buf.data, city_data.buf.size)) {
+    if (!read_compressed_chunk(fp, city_data->buf.data, city_data->buf.size)) {
         return 0;
     }
 
@@ -1092,13 +1182,13 @@ static int savegame_read_file_info(FILE *fp, saved_game_info *info, int version)
     skip_piece(fp, 64, 0);
     skip_piece(fp, 4, 0);
 
-    if (!prepare_dynamic_piece(fp, &buildings) || !read_compressed_chunk(fp, buildings.buf.data, buildings.buf.size)) {
+    if (!prepare_dynamic_piece(fp, buildings) || !read_compressed_chunk(fp, buildings->buf.data, buildings->buf.size)) {
         return 0;
     }
 
     skip_piece(fp, 4, 0);
 
-    if (fread(game_time.buf.data, 1, game_time.buf.size, fp) != game_time.buf.size) {
+    if (fread(game_time->buf.data, 1, game_time->buf.size, fp) != game_time->buf.size) {
         return 0;
     }
 
@@ -1115,7 +1205,7 @@ static int savegame_read_file_info(FILE *fp, saved_game_info *info, int version)
     skip_piece(fp, 84, 0);
     skip_piece(fp, 60, 0);
 
-    if (fread(scenario.buf.data, 1, scenario.buf.size, fp) != scenario.buf.size) {
+    if (fread(scenario->buf.data, 1, scenario->buf.size, fp) != scenario->buf.size) {
         return 0;
     }
 
@@ -1134,16 +1224,13 @@ static int savegame_read_file_info(FILE *fp, saved_game_info *info, int version)
 
     info->custom_mission = read_int32(fp);
 
-    city_data_load_basic_info(&city_data.buf, &info->population, &info->treasury, &minimap_data.caravanserai_id);
-    game_time_load_basic_info(&game_time.buf, &info->month, &info->year);
-
-    int grid_start;
-    int grid_border_size;
+    city_data_load_basic_info(&city_data->buf, &info->population, &info->treasury, &minimap_data.caravanserai_id);
+    game_time_load_basic_info(&game_time->buf, &info->month, &info->year);
 
     minimap_data.version = version;
-    scenario_map_data_from_buffer(&scenario.buf, &minimap_data.city_width, &minimap_data.city_height,
-        &grid_start, &grid_border_size);
-    minimap_data.climate = scenario_climate_from_buffer(&scenario.buf);
+    scenario_map_data_from_buffer(&scenario->buf, &minimap_data.city_width, &minimap_data.city_height,
+        &minimap_data.grid_start, &minimap_data.grid_border_size);
+    minimap_data.climate = scenario_climate_from_buffer(&scenario->buf);
     minimap_data.functions.building = savegame_building;
     minimap_data.functions.climate = get_climate;
     minimap_data.functions.map.width = map_width;
@@ -1155,42 +1242,110 @@ static int savegame_read_file_info(FILE *fp, saved_game_info *info, int version)
     minimap_data.functions.offset.random = savegame_random_at;
     minimap_data.functions.offset.terrain = savegame_terrain_at;
     minimap_data.functions.offset.tile_size = savegame_tile_size_at;
+    minimap_data.functions.offset.tile_type = 0;
 
-    city_view_set_custom_lookup(grid_start, minimap_data.city_width, minimap_data.city_height, grid_border_size);
-    widget_minimap_update(&minimap_data.functions);
+    // store the tile types instead of drawing the minimap directly, so they can be saved in the index
+    memset(minimap_data.tile_types, 0, sizeof(minimap_data.tile_types));
+    city_view_set_custom_lookup(minimap_data.grid_start, minimap_data.city_width, minimap_data.city_height,
+        minimap_data.grid_border_size);
+    widget_minimap_store_tile_types(&minimap_data.functions, minimap_data.tile_types);
     city_view_restore_lookup();
 
-    free_file_piece(&city_data);
-    free_file_piece(&game_time);
-    free_file_piece(&terrain_grid);
-    free_file_piece(&scenario);
-    free_file_piece(&random_grid);
-    free_file_piece(&edge_grid);
-    free_file_piece(&bitfields_grid);
-    free_file_piece(&building_grid);
-    free_file_piece(&buildings);
+    update_savegame_minimap();
 
     return 1;
 }
 
+static int read_saved_game_info_from_index(const char *filename, int size, int64_t modified, saved_game_info *info)
+{
+    int data_size;
+    const uint8_t *index_data = savegame_index_get(filename, size, modified, &data_size);
+    if (!index_data || data_size <= SAVEGAME_INFO_INDEX_HEADER_SIZE) {
+        return 0;
+    }
+    buffer buf;
+    buffer_init(&buf, (uint8_t *) index_data, data_size);
+    info->mission = buffer_read_i32(&buf);
+    info->custom_mission = buffer_read_i32(&buf);
+    info->treasury = buffer_read_i32(&buf);
+    info->population = buffer_read_i32(&buf);
+    info->month = buffer_read_i32(&buf);
+    info->year = buffer_read_i32(&buf);
+    minimap_data.city_width = buffer_read_i32(&buf);
+    minimap_data.city_height = buffer_read_i32(&buf);
+    minimap_data.grid_start = buffer_read_i32(&buf);
+    minimap_data.grid_border_size = buffer_read_i32(&buf);
+    minimap_data.climate = buffer_read_i32(&buf);
+    int tile_types_size = buffer_read_i32(&buf);
+
+    int bytes_read = sizeof(minimap_data.tile_types);
+    if (tile_types_size != data_size - SAVEGAME_INFO_INDEX_HEADER_SIZE ||
+        !zip_decompress(&index_data[SAVEGAME_INFO_INDEX_HEADER_SIZE], tile_types_size,
+            minimap_data.tile_types, &bytes_read) || bytes_read != sizeof(minimap_data.tile_types)) {
+        return 0;
+    }
+    update_savegame_minimap();
+    return 1;
+}
+
+static void write_saved_game_info_to_index(const char *filename, int size, int64_t modified,
+    const saved_game_info *info)
+{
+    static uint8_t index_data[SAVEGAME_INFO_INDEX_HEADER_SIZE + GRID_SIZE * GRID_SIZE];
+    int tile_types_size = sizeof(index_data) - SAVEGAME_INFO_INDEX_HEADER_SIZE;
+    if (!zip_compress(minimap_data.tile_types, sizeof(minimap_data.tile_types),
+            &index_data[SAVEGAME_INFO_INDEX_HEADER_SIZE], &tile_types_size)) {
+        return;
+    }
+    buffer buf;
+    buffer_init(&buf, index_data, SAVEGAME_INFO_INDEX_HEADER_SIZE);
+    buffer_write_i32(&buf, info->mission);
+    buffer_write_i32(&buf, info->custom_mission);
+    buffer_write_i32(&buf, info->treasury);
+    buffer_write_i32(&buf, info->population);
+    buffer_write_i32(&buf, info->month);
+    buffer_write_i32(&buf, info->year);
+    buffer_write_i32(&buf, minimap_data.city_width);
+    buffer_write_i32(&buf, minimap_data.city_height);
+    buffer_write_i32(&buf, minimap_data.grid_start);
+    buffer_write_i32(&buf, minimap_data.grid_border_size);
+    buffer_write_i32(&buf, minimap_data.climate);
+    buffer_write_i32(&buf, tile_types_size);
+    savegame_index_set(filename, size, modified, index_data, SAVEGAME_INFO_INDEX_HEADER_SIZE + tile_types_size);
+}
+
 int game_file_io_read_saved_game_info(const char *filename, saved_game_info *info)
 {
     FILE *fp = file_open(dir_get_file(filename, NOT_LOCALIZED), "rb");
     if (!fp) {
         return 0;
     }
+    int size;
+    int64_t modified;
+    int has_stamp = file_get_stamp(fp, &size, &modified);
+    if (has_stamp && read_saved_game_info_from_index(filename, size, modified, info)) {
+        file_close(fp);
+        return 1;
+    }
     int result = 0;
     int version = get_savegame_version(fp);
     if (version && version <= SAVE_GAME_CURRENT_VERSION) {
         result = savegame_read_file_info(fp, info, version);
     }
     file_close(fp);
+    if (result && has_stamp) {
+        write_saved_game_info_to_index(filename, size, modified, info);
+    }
     return result;
 }
 
 int game_file_io_write_saved_game(const char *filename)
 {
-    init_savegame_data(SAVE_GAME_CURRENT_VERSION);
+    if (!init_savegame_data(SAVE_GAME_CURRENT_VERSION)) {
+        log_error("Unable to save game", 0, 0);
+        return 0;
+    }
+    clear_savegame_piece_contents();
 
     log_info("Saving game", filename, 0);
     savegame_save_to_state(&savegame_data.state);
@@ -1201,13 +1356,42 @@ int game_file_io_write_saved_game(const char *filename)
         return 0;
     }
     savegame_write_to_file(fp);
+    fflush(fp);
+    // a file overwritten within the same second may keep its size and modification time
+    int size;
+    int64_t modified;
+    if (file_get_stamp(fp, &size, &modified)) {
+        savegame_index_remove_if_unchanged(filename, size, modified);
+    } else {
+        savegame_index_remove(filename);
+    }
     file_close(fp);
     return 1;
 }
 
+uint32_t game_file_io_saved_game_hash(void)
+{
+    if (!init_savegame_data(SAVE_GAME_CURRENT_VERSION)) {
+        return 0;
+    }
+    clear_savegame_piece_contents();
+    savegame_save_to_state(&savegame_data.state);
+
+    // FNV-1a over the uncompressed pieces, so no file has to be written
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        const buffer *buf = &savegame_data.pieces[i].buf;
+        for (int j = 0; j < buf->size; j++) {
+            hash = (hash ^ buf->data[j]) * 16777619u;
+        }
+    }
+    return hash;
+}
+
 int game_file_io_delete_saved_game(const char *filename)
 {
     log_info("Deleting game", filename, 0);
+    savegame_index_remove(filename);
     int result = file_remove(filename);
     if (!result) {
         log_error("Unable to delete game", 0, 0);
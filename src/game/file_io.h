@@ -37,6 +37,12 @@ int game_file_io_read_saved_game_info(const char *filename, saved_game_info *inf
 
 int game_file_io_write_saved_game(const char *filename);
 
+/**
+ * Calculates a hash of the current game state as it would be written to a saved game
+ * @return Hash of the saved game data
+ */
+uint32_t game_file_io_saved_game_hash(void);
+
 int game_file_io_delete_saved_game(const char *filename);
 
 #endif // GAME_FILE_IO_H
@@ -16,11 +16,14 @@
 #include "game/animation.h"
 #include "game/file.h"
 #include "game/file_editor.h"
+#include "game/replay.h"
 #include "game/settings.h"
 #include "game/speed.h"
 #include "game/state.h"
+#include "game/system.h"
 #include "game/tick.h"
 #include "graphics/font.h"
+#include "graphics/text.h"
 #include "graphics/video.h"
 #include "graphics/window.h"
 #include "scenario/property.h"
@@ -43,6 +46,7 @@ static encoding_type update_encoding(void)
     encoding_type encoding = encoding_determine(language);
     log_info("Detected encoding:", 0, encoding);
     font_set_encoding(encoding);
+    text_clear_cache();
     translation_load(language);
     return encoding;
 }
@@ -172,14 +176,24 @@ void game_run(void)
 {
     game_animation_update();
     int num_ticks = game_speed_get_elapsed_ticks();
-    for (int i = 0; i < num_ticks; i++) {
+    // turbo runs ticks until the frame time is used up, the other speeds run every elapsed tick
+    time_millis max_millis = game_speed_get_turbo_frame_millis();
+    time_millis start = system_get_millis();
+    int ticks_run = 0;
+    while (ticks_run < num_ticks) {
         game_tick_run();
+        game_replay_record_tick();
         game_file_write_mission_saved_game();
+        ticks_run++;
 
         if (window_is_invalid()) {
             break;
         }
+        if (max_millis && system_get_millis() - start >= max_millis) {
+            break;
+        }
     }
+    game_speed_count_ticks(ticks_run);
 }
 
 void game_draw(void)
@@ -190,6 +204,7 @@ void game_draw(void)
 
 void game_exit(void)
 {
+    game_replay_stop_recording();
     video_shutdown();
     settings_save();
     config_save();
@@ -0,0 +1,245 @@
+#include "replay.h"
+
+#include "building/construction.h"
+#include "building/rotation.h"
+#include "city/finance.h"
+#include "city/labor.h"
+#include "core/array.h"
+#include "core/file.h"
+#include "core/log.h"
+#include "figure/formation.h"
+#include "figure/formation_legion.h"
+#include "game/file_io.h"
+#include "game/orientation.h"
+#include "game/tick.h"
+#include "game/undo.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define REPLAY_VERSION 1
+#define REPLAY_MAX_ARGS 9
+#define COMMAND_ARRAY_SIZE_STEP 256
+
+typedef struct {
+    int tick;
+    replay_command_type type;
+    int args[REPLAY_MAX_ARGS];
+} replay_command;
+
+static struct {
+    char record_file[FILE_NAME_MAX];
+    FILE *fp;
+    int ticks;
+    array(replay_command) commands;
+    int next_command;
+} data;
+
+void game_replay_set_record_file(const char *filename)
+{
+    if (!filename) {
+        data.record_file[0] = 0;
+        return;
+    }
+    strncpy(data.record_file, filename, FILE_NAME_MAX - 1);
+    data.record_file[FILE_NAME_MAX - 1] = 0;
+}
+
+void game_replay_start_recording(void)
+{
+    game_replay_stop_recording();
+    if (!data.record_file[0]) {
+        return;
+    }
+    char save_file[FILE_NAME_MAX + 4];
+    snprintf(save_file, FILE_NAME_MAX + 4, "%s.sav", data.record_file);
+    if (!game_file_io_write_saved_game(save_file)) {
+        return;
+    }
+    data.fp = file_open(data.record_file, "w");
+    if (!data.fp) {
+        log_error("Unable to record game to", data.record_file, 0);
+        return;
+    }
+    log_info("Recording game to", data.record_file, 0);
+    fprintf(data.fp, "augustus-replay %d\n", REPLAY_VERSION);
+    data.ticks = 0;
+    // only record a single session
+    data.record_file[0] = 0;
+}
+
+void game_replay_stop_recording(void)
+{
+    if (data.fp) {
+        file_close(data.fp);
+        data.fp = 0;
+    }
+}
+
+int game_replay_is_recording(void)
+{
+    return data.fp != 0;
+}
+
+void game_replay_record_tick(void)
+{
+    data.ticks++;
+}
+
+static void write_command(const replay_command *command)
+{
+    fprintf(data.fp, "%d %d", command->tick, command->type);
+    for (int i = 0; i < REPLAY_MAX_ARGS; i++) {
+        fprintf(data.fp, " %d", command->args[i]);
+    }
+    fprintf(data.fp, "\n");
+    fflush(data.fp);
+}
+
+void game_replay_record(replay_command_type type, int arg1, int arg2, int arg3)
+{
+    if (!data.fp) {
+        return;
+    }
+    replay_command command = { data.ticks, type, { arg1, arg2, arg3 } };
+    write_command(&command);
+}
+
+void game_replay_record_construction(building_type type, building_type sub_type,
+    int x_start, int y_start, int x_end, int y_end)
+{
+    if (!data.fp) {
+        return;
+    }
+    replay_command command = { data.ticks, REPLAY_COMMAND_CONSTRUCTION,
+        { type, sub_type, x_start, y_start, x_end, y_end } };
+    building_rotation_get_state(&command.args[6], &command.args[7], &command.args[8]);
+    write_command(&command);
+}
+
+static int load_failed(FILE *fp)
+{
+    if (fp) {
+        file_close(fp);
+    }
+    array_clear(data.commands);
+    return -1;
+}
+
+int game_replay_load(const char *filename)
+{
+    if (!array_init(data.commands, COMMAND_ARRAY_SIZE_STEP, 0, 0)) {
+        log_error("Unable to allocate enough memory for the replay commands", 0, 0);
+        return load_failed(0);
+    }
+    data.next_command = 0;
+    data.ticks = 0;
+    FILE *fp = file_open(filename, "r");
+    if (!fp) {
+        log_error("Unable to open replay", filename, 0);
+        return load_failed(0);
+    }
+    int version = 0;
+    if (fscanf(fp, "augustus-replay %d", &version) != 1 || version != REPLAY_VERSION) {
+        log_error("Unsupported replay version", filename, version);
+        return load_failed(fp);
+    }
+    replay_command command;
+    int type;
+    while (fscanf(fp, "%d %d", &command.tick, &type) == 2) {
+        for (int i = 0; i < REPLAY_MAX_ARGS; i++) {
+            if (fscanf(fp, "%d", &command.args[i]) != 1) {
+                log_error("Truncated replay command at tick", 0, command.tick);
+                return load_failed(fp);
+            }
+        }
+        if (type <= REPLAY_COMMAND_NONE || type >= REPLAY_COMMAND_MAX) {
+            log_error("Unknown replay command", 0, type);
+            continue;
+        }
+        command.type = type;
+        replay_command *item = array_advance(data.commands);
+        if (!item) {
+            log_error("Unable to allocate enough memory for the replay commands", 0, 0);
+            return load_failed(fp);
+        }
+        *item = command;
+    }
+    file_close(fp);
+    return data.commands.size;
+}
+
+static void rotate_map(int direction)
+{
+    switch (direction) {
+        case REPLAY_ROTATE_MAP_LEFT:
+            game_orientation_rotate_left();
+            break;
+        case REPLAY_ROTATE_MAP_RIGHT:
+            game_orientation_rotate_right();
+            break;
+        default:
+            game_orientation_rotate_north();
+            break;
+    }
+}
+
+static void apply_command(const replay_command *command)
+{
+    const int *args = command->args;
+    switch (command->type) {
+        case REPLAY_COMMAND_CONSTRUCTION:
+            building_rotation_set_state(args[6], args[7], args[8]);
+            building_construction_replay(args[0], args[1], args[2], args[3], args[4], args[5]);
+            break;
+        case REPLAY_COMMAND_UNDO:
+            game_undo_perform();
+            break;
+        case REPLAY_COMMAND_ROTATE_MAP:
+            rotate_map(args[0]);
+            break;
+        case REPLAY_COMMAND_LABOR_PRIORITY:
+            city_labor_set_priority(args[0], args[1]);
+            break;
+        case REPLAY_COMMAND_WAGES:
+            city_labor_change_wages(args[0]);
+            city_finance_estimate_wages();
+            city_finance_calculate_totals();
+            break;
+        case REPLAY_COMMAND_TAXES:
+            city_finance_change_tax_percentage(args[0]);
+            city_finance_estimate_taxes();
+            city_finance_calculate_totals();
+            break;
+        case REPLAY_COMMAND_LEGION_MOVE:
+            formation_legion_move_to(formation_get(args[0]), args[1], args[2]);
+            break;
+        case REPLAY_COMMAND_LEGION_RETURN_HOME:
+            formation_legion_return_home(formation_get(args[0]));
+            break;
+        case REPLAY_COMMAND_LEGION_LAYOUT:
+            formation_legion_change_layout(formation_get(args[0]), args[1]);
+            break;
+        case REPLAY_COMMAND_LEGION_EMPIRE_SERVICE:
+            formation_toggle_empire_service(args[0]);
+            formation_calculate_figures();
+            break;
+        default:
+            break;
+    }
+}
+
+int game_replay_run_tick(void)
+{
+    while (data.next_command < data.commands.size) {
+        const replay_command *command = array_item(data.commands, data.next_command);
+        if (command->tick > data.ticks) {
+            break;
+        }
+        apply_command(command);
+        data.next_command++;
+    }
+    game_tick_run();
+    data.ticks++;
+    return data.next_command < data.commands.size;
+}
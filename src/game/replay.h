@@ -0,0 +1,82 @@
+#ifndef GAME_REPLAY_H
+#define GAME_REPLAY_H
+
+#include "building/type.h"
+
+/**
+ * @file
+ * Recording and replaying of player commands.
+ * A recording consists of a saved game with the state at the start of the session and a text file
+ * with the commands, each tagged with the number of game ticks that passed before it was given.
+ */
+
+typedef enum {
+    REPLAY_COMMAND_NONE = 0,
+    REPLAY_COMMAND_CONSTRUCTION = 1,
+    REPLAY_COMMAND_UNDO = 2,
+    REPLAY_COMMAND_ROTATE_MAP = 3,
+    REPLAY_COMMAND_LABOR_PRIORITY = 4,
+    REPLAY_COMMAND_WAGES = 5,
+    REPLAY_COMMAND_TAXES = 6,
+    REPLAY_COMMAND_LEGION_MOVE = 7,
+    REPLAY_COMMAND_LEGION_RETURN_HOME = 8,
+    REPLAY_COMMAND_LEGION_LAYOUT = 9,
+    REPLAY_COMMAND_LEGION_EMPIRE_SERVICE = 10,
+    REPLAY_COMMAND_MAX
+} replay_command_type;
+
+typedef enum {
+    REPLAY_ROTATE_MAP_NORTH = 0,
+    REPLAY_ROTATE_MAP_LEFT = 1,
+    REPLAY_ROTATE_MAP_RIGHT = 2
+} replay_rotate_map;
+
+/**
+ * Sets the file to record the next game session to. The start state is saved to the same filename with ".sav" appended
+ * @param filename File to record to, or 0 to disable recording
+ */
+void game_replay_set_record_file(const char *filename);
+
+/**
+ * Starts recording, if a record file was set. Called when a game has been loaded or started
+ */
+void game_replay_start_recording(void);
+
+void game_replay_stop_recording(void);
+
+int game_replay_is_recording(void);
+
+/**
+ * Advances the tick counter of the recording. Called after every game tick
+ */
+void game_replay_record_tick(void);
+
+/**
+ * Records a player command
+ * @param type Command type
+ * @param arg1 First argument, meaning depends on the command
+ * @param arg2 Second argument, meaning depends on the command
+ * @param arg3 Third argument, meaning depends on the command
+ */
+void game_replay_record(replay_command_type type, int arg1, int arg2, int arg3);
+
+/**
+ * Records the placement of a building, including the current building rotation
+ */
+void game_replay_record_construction(building_type type, building_type sub_type,
+    int x_start, int y_start, int x_end, int y_end);
+
+/**
+ * Loads the commands of a recording. The game should be loaded from the start save separately
+ * @param filename Command file
+ * @return The number of commands loaded, or -1 if the file could not be read
+ */
+int game_replay_load(const char *filename);
+
+/**
+ * Applies the commands due at the current tick, then runs one game tick
+ * @return 1 if there are commands left to replay, 0 otherwise
+ */
+int game_replay_run_tick(void);
+
+#endif // GAME_REPLAY_H
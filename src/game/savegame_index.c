@@ -0,0 +1,294 @@
+#include "savegame_index.h"
+
+#include "core/array.h"
+#include "core/buffer.h"
+#include "core/file.h"
+#include "core/log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INDEX_FILE "savegames.idx"
+#define INDEX_MAGIC 0x58444953 // "SIDX"
+#define INDEX_VERSION 1
+#define INDEX_MAX_FILE_SIZE (64 * 1024 * 1024)
+#define ENTRY_ARRAY_SIZE_STEP 64
+
+typedef struct {
+    char filename[FILE_NAME_MAX];
+    int size;
+    int64_t modified;
+    uint8_t *data;
+    int data_size;
+} index_entry;
+
+static struct {
+    array(index_entry) entries;
+    int loaded;
+    int changed;
+    int write_failed;
+    char directory[FILE_NAME_MAX];
+    char path[FILE_NAME_MAX];
+} data;
+
+static int entry_in_use(const index_entry *entry)
+{
+    return entry->data != 0;
+}
+
+static void free_entry(index_entry *entry)
+{
+    free(entry->data);
+    memset(entry, 0, sizeof(index_entry));
+}
+
+// Splits a saved game path into the directory, including the trailing separator, and the file name
+static const char *split_path(const char *path, char *directory)
+{
+    const char *name = path;
+    for (const char *c = path; *c; c++) {
+        if (*c == '/' || *c == '\\') {
+            name = c + 1;
+        }
+    }
+    size_t length = name - path < FILE_NAME_MAX ? name - path : FILE_NAME_MAX - 1;
+    memcpy(directory, path, length);
+    directory[length] = 0;
+    return name;
+}
+
+// Sets the path of the index file of the current directory, or an empty path if it does not fit
+static void set_index_path(void)
+{
+    char index_file[FILE_NAME_MAX];
+    data.path[0] = 0;
+    if (snprintf(index_file, FILE_NAME_MAX, "%s%s", data.directory, INDEX_FILE) >= FILE_NAME_MAX) {
+        return;
+    }
+    // read and write the same, case corrected, file
+    const char *cased_path = dir_get_file(index_file, NOT_LOCALIZED);
+    if (snprintf(data.path, FILE_NAME_MAX, "%s", cased_path ? cased_path : index_file) >= FILE_NAME_MAX) {
+        data.path[0] = 0;
+    }
+}
+
+static index_entry *find_entry(const char *filename)
+{
+    index_entry *entry;
+    array_foreach(data.entries, entry) {
+        if (entry_in_use(entry) && strcmp(entry->filename, filename) == 0) {
+            return entry;
+        }
+    }
+    return 0;
+}
+
+static index_entry *add_entry(const char *filename, int size, int64_t modified, const uint8_t *entry_data,
+    int data_size)
+{
+    index_entry *entry = find_entry(filename);
+    if (!entry) {
+        array_new_item(data.entries, 0, entry);
+        if (!entry) {
+            return 0;
+        }
+    }
+    uint8_t *copy = malloc(data_size);
+    if (!copy) {
+        free_entry(entry);
+        return 0;
+    }
+    memcpy(copy, entry_data, data_size);
+    free(entry->data);
+    strncpy(entry->filename, filename, FILE_NAME_MAX - 1);
+    entry->filename[FILE_NAME_MAX - 1] = 0;
+    entry->size = size;
+    entry->modified = modified;
+    entry->data = copy;
+    entry->data_size = data_size;
+    return entry;
+}
+
+static void read_index(buffer *buf)
+{
+    if (buffer_read_u32(buf) != INDEX_MAGIC || buffer_read_i32(buf) != INDEX_VERSION) {
+        return;
+    }
+    int num_entries = buffer_read_i32(buf);
+    char filename[FILE_NAME_MAX];
+    for (int i = 0; i < num_entries && !buffer_at_end(buf); i++) {
+        int name_length = buffer_read_i32(buf);
+        if (name_length <= 0 || name_length >= FILE_NAME_MAX) {
+            return;
+        }
+        buffer_read_raw(buf, filename, name_length);
+        filename[name_length] = 0;
+        int size = buffer_read_i32(buf);
+        uint32_t modified_low = buffer_read_u32(buf);
+        uint32_t modified_high = buffer_read_u32(buf);
+        int data_size = buffer_read_i32(buf);
+        if (data_size <= 0 || buf->index + data_size > buf->size) {
+            return;
+        }
+        int64_t modified = (int64_t) (((uint64_t) modified_high << 32) | modified_low);
+        add_entry(filename, size, modified, &buf->data[buf->index], data_size);
+        buffer_skip(buf, data_size);
+    }
+}
+
+static void write_index(void)
+{
+    if (!data.path[0]) {
+        return;
+    }
+    int file_size = 12;
+    int num_entries = 0;
+    index_entry *entry;
+    array_foreach(data.entries, entry) {
+        if (entry_in_use(entry)) {
+            file_size += 20 + (int) strlen(entry->filename) + entry->data_size;
+            num_entries++;
+        }
+    }
+    uint8_t *contents = malloc(file_size);
+    if (!contents) {
+        log_error("Unable to allocate memory for the saved game index", 0, 0);
+        return;
+    }
+    buffer buf;
+    buffer_init(&buf, contents, file_size);
+    buffer_write_u32(&buf, INDEX_MAGIC);
+    buffer_write_i32(&buf, INDEX_VERSION);
+    buffer_write_i32(&buf, num_entries);
+    array_foreach(data.entries, entry) {
+        if (entry_in_use(entry)) {
+            int name_length = (int) strlen(entry->filename);
+            buffer_write_i32(&buf, name_length);
+            buffer_write_raw(&buf, entry->filename, name_length);
+            buffer_write_i32(&buf, entry->size);
+            buffer_write_u32(&buf, (uint32_t) ((uint64_t) entry->modified & 0xffffffff));
+            buffer_write_u32(&buf, (uint32_t) ((uint64_t) entry->modified >> 32));
+            buffer_write_i32(&buf, entry->data_size);
+            buffer_write_raw(&buf, entry->data, entry->data_size);
+        }
+    }
+    FILE *fp = file_open(data.path, "wb");
+    if (fp) {
+        fwrite(contents, 1, file_size, fp);
+        file_close(fp);
+    } else if (!data.write_failed) {
+        // the directory may be read-only: log it once instead of on every change
+        log_error("Unable to write saved game index", data.path, 0);
+        data.write_failed = 1;
+    }
+    free(contents);
+    data.changed = 0;
+}
+
+static void load_index(const char *directory)
+{
+    if (data.changed) {
+        write_index();
+    }
+    data.loaded = 1;
+    data.changed = 0;
+    data.write_failed = 0;
+    strncpy(data.directory, directory, FILE_NAME_MAX - 1);
+    data.directory[FILE_NAME_MAX - 1] = 0;
+    // array_init frees the entry array, but not the data of the entries
+    index_entry *entry;
+    array_foreach(data.entries, entry) {
+        if (entry_in_use(entry)) {
+            free(entry->data);
+        }
+    }
+    if (!array_init(data.entries, ENTRY_ARRAY_SIZE_STEP, 0, entry_in_use)) {
+        log_error("Unable to allocate memory for the saved game index", 0, 0);
+        data.loaded = 0;
+        return;
+    }
+    set_index_path();
+    if (!data.path[0]) {
+        log_info("Saved game directory name too long, not indexing", directory, 0);
+        return;
+    }
+    FILE *fp = file_open(data.path, "rb");
+    if (!fp) {
+        return;
+    }
+    fseek(fp, 0, SEEK_END);
+    long file_size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (file_size <= 0 || file_size > INDEX_MAX_FILE_SIZE) {
+        file_close(fp);
+        return;
+    }
+    uint8_t *contents = malloc(file_size);
+    if (contents && fread(contents, 1, file_size, fp) == (size_t) file_size) {
+        buffer buf;
+        buffer_init(&buf, contents, (int) file_size);
+        read_index(&buf);
+    }
+    free(contents);
+    file_close(fp);
+}
+
+// Loads the index of the directory of a saved game, and returns the name of the saved game within that directory
+static const char *use_index_for(const char *filename)
+{
+    char directory[FILE_NAME_MAX];
+    const char *name = split_path(filename, directory);
+    if (!data.loaded || strcmp(directory, data.directory) != 0) {
+        load_index(directory);
+    }
+    return name;
+}
+
+const uint8_t *savegame_index_get(const char *filename, int size, int64_t modified, int *data_size)
+{
+    const index_entry *entry = find_entry(use_index_for(filename));
+    if (!entry || entry->size != size || entry->modified != modified) {
+        return 0;
+    }
+    *data_size = entry->data_size;
+    return entry->data;
+}
+
+void savegame_index_set(const char *filename, int size, int64_t modified, const uint8_t *entry_data, int data_size)
+{
+    const char *name = use_index_for(filename);
+    const index_entry *entry = find_entry(name);
+    if (entry && entry->size == size && entry->modified == modified && entry->data_size == data_size &&
+        memcmp(entry->data, entry_data, data_size) == 0) {
+        return;
+    }
+    if (data.path[0] && add_entry(name, size, modified, entry_data, data_size)) {
+        data.changed = 1;
+    }
+}
+
+void savegame_index_write_changes(void)
+{
+    if (data.loaded && data.changed) {
+        write_index();
+    }
+}
+
+void savegame_index_remove(const char *filename)
+{
+    index_entry *entry = find_entry(use_index_for(filename));
+    if (entry) {
+        free_entry(entry);
+        write_index();
+    }
+}
+
+void savegame_index_remove_if_unchanged(const char *filename, int size, int64_t modified)
+{
+    index_entry *entry = find_entry(use_index_for(filename));
+    if (entry && entry->size == size && entry->modified == modified) {
+        free_entry(entry);
+        write_index();
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef GAME_SAVEGAME_INDEX_H
+#define GAME_SAVEGAME_INDEX_H
+
+#include <stdint.h>
+
+/**
+ * @file
+ * Index of the information shown for saved games in the file dialog.
+ * Every directory with saved games has its own index file. Entries are keyed by the file name, size and modification
+ * time of the saved game, so they are only rebuilt when a saved game has changed.
+ * New entries are kept in memory until savegame_index_write_changes() is called, so a directory listing
+ * writes the index file at most once. Removed entries are written right away.
+ */
+
+/**
+ * Gets the indexed data for a saved game
+ * @param filename Saved game file name
+ * @param size Size of the saved game file
+ * @param modified Modification time of the saved game file
+ * @param data_size Out: size of the data
+ * @return The data, or 0 if the saved game is not indexed or has changed since it was indexed
+ */
+const uint8_t *savegame_index_get(const char *filename, int size, int64_t modified, int *data_size);
+
+/**
+ * Stores the data for a saved game in the index, unless the same data was already stored.
+ * The index file is not written until savegame_index_write_changes() is called
+ * @param filename Saved game file name
+ * @param size Size of the saved game file
+ * @param modified Modification time of the saved game file
+ * @param data Data to store
+ * @param data_size Size of the data
+ */
+void savegame_index_set(const char *filename, int size, int64_t modified, const uint8_t *data, int data_size);
+
+/**
+ * Writes the index file if entries were stored since it was last written
+ */
+void savegame_index_write_changes(void);
+
+/**
+ * Removes a saved game from the index
+ * @param filename Saved game file name
+ */
+void savegame_index_remove(const char *filename);
+
+/**
+ * Removes a saved game from the index if its entry has the given size and modification time.
+ * Used after overwriting a saved game, which may keep the size and modification time of the old file
+ * @param filename Saved game file name
+ * @param size Size of the saved game file
+ * @param modified Modification time of the saved game file
+ */
+void savegame_index_remove_if_unchanged(const char *filename, int size, int64_t modified);
+
+#endif // GAME_SAVEGAME_INDEX_H
@@ -3,6 +3,7 @@
 #include "city/constants.h"
 #include "core/buffer.h"
 #include "core/calc.h"
+#include "core/config.h"
 #include "core/io.h"
 #include "core/string.h"
 
@@ -76,7 +77,7 @@ static void load_settings(buffer *buf)
     data.sound_music.enabled = buffer_read_u8(buf);
     data.sound_speech.enabled = buffer_read_u8(buf);
     buffer_skip(buf, 6);
-    data.game_speed = buffer_read_i32(buf);
+    data.game_speed = calc_bound(buffer_read_i32(buf), 10, 500);
     data.scroll_speed = buffer_read_i32(buf);
     buffer_read_raw(buf, data.player_name, MAX_PLAYER_NAME);
     buffer_skip(buf, 16);
@@ -245,7 +246,8 @@ void setting_reset_sound(set_sound_type type, int enabled, int volume)
 
 int setting_game_speed(void)
 {
-    return data.game_speed;
+    // turbo is kept out of c3.inf, which older versions read as a regular speed
+    return config_get(CONFIG_GP_TURBO) ? SETTING_GAME_SPEED_TURBO : data.game_speed;
 }
 
 void setting_increase_game_speed(void)
@@ -253,6 +255,8 @@ void setting_increase_game_speed(void)
     if (data.game_speed >= 100) {
         if (data.game_speed < 500) {
             data.game_speed += 100;
+        } else {
+            config_set(CONFIG_GP_TURBO, 1);
         }
     } else {
         data.game_speed = calc_bound(data.game_speed + 10, 10, 100);
@@ -261,7 +265,9 @@ void setting_increase_game_speed(void)
 
 void setting_decrease_game_speed(void)
 {
-    if (data.game_speed > 100) {
+    if (config_get(CONFIG_GP_TURBO)) {
+        config_set(CONFIG_GP_TURBO, 0);
+    } else if (data.game_speed > 100) {
         data.game_speed -= 100;
     } else {
         data.game_speed = calc_bound(data.game_speed - 10, 10, 100);
@@ -270,6 +276,7 @@ void setting_decrease_game_speed(void)
 
 void setting_set_default_game_speed(void)
 {
+    config_set(CONFIG_GP_TURBO, 0);
     data.game_speed = 70;
 }
 
@@ -290,7 +297,8 @@ void setting_decrease_scroll_speed(void)
 
 void setting_reset_speeds(int game_speed, int scroll_speed)
 {
-    data.game_speed = game_speed;
+    config_set(CONFIG_GP_TURBO, game_speed == SETTING_GAME_SPEED_TURBO);
+    data.game_speed = calc_bound(game_speed, 10, 500);
     data.scroll_speed = scroll_speed;
 }
 
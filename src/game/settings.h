@@ -3,6 +3,9 @@
 
 #include <stdint.h>
 
+// returned as the game speed while the turbo config flag is set
+#define SETTING_GAME_SPEED_TURBO 1000
+
 typedef enum {
     TOOLTIPS_NONE = 0,
     TOOLTIPS_SOME = 1,
@@ -1,6 +1,7 @@
 #include "game/speed.h"
 
 #include "building/construction.h"
+#include "core/config.h"
 #include "core/time.h"
 #include "game/settings.h"
 #include "game/state.h"
@@ -8,6 +9,8 @@
 #include "input/scroll.h"
 
 #define MAX_TICKS_PER_FRAME 20
+#define MAX_TICKS_PER_TURBO_FRAME 10000
+#define MIN_TURBO_FRAME_MILLIS 10
 
 static const time_millis MILLIS_PER_TICK_PER_SPEED[] = {
     702, 502, 352, 242, 162, 112, 82, 57, 37, 22, 16
@@ -19,6 +22,11 @@ static const time_millis MILLIS_PER_HYPER_SPEED[] = {
 static struct {
     int last_check_was_valid;
     time_millis last_update;
+    struct {
+        time_millis start;
+        int ticks;
+        int per_second;
+    } ticks_counter;
 } data;
 
 int game_speed_get_elapsed_ticks(void)
@@ -39,7 +47,10 @@ int game_speed_get_elapsed_ticks(void)
         case WINDOW_MILITARY_MENU:
         case WINDOW_BUILD_MENU: {
             int speed = setting_game_speed();
-            if (speed < 10) {
+            if (speed == SETTING_GAME_SPEED_TURBO) {
+                millis_per_tick = 0;
+                break;
+            } else if (speed < 10) {
                 return 0;
             } else if (speed <= 100) {
                 millis_per_tick = MILLIS_PER_TICK_PER_SPEED[speed / 10];
@@ -70,6 +81,11 @@ int game_speed_get_elapsed_ticks(void)
         data.last_update = now;
         return 1;
     }
+    if (!millis_per_tick) {
+        // turbo: as many ticks as fit in the frame time
+        data.last_update = now;
+        return MAX_TICKS_PER_TURBO_FRAME;
+    }
     int ticks = diff / millis_per_tick;
     if (!ticks) {
         return 0;
@@ -81,3 +97,29 @@ int game_speed_get_elapsed_ticks(void)
         return MAX_TICKS_PER_FRAME;
     }
 }
+
+int game_speed_get_turbo_frame_millis(void)
+{
+    if (setting_game_speed() != SETTING_GAME_SPEED_TURBO) {
+        return 0;
+    }
+    int millis = config_get(CONFIG_GP_TURBO_FRAME_MILLIS);
+    return millis > MIN_TURBO_FRAME_MILLIS ? millis : MIN_TURBO_FRAME_MILLIS;
+}
+
+void game_speed_count_ticks(int ticks)
+{
+    time_millis now = time_get_millis();
+    time_millis elapsed = now - data.ticks_counter.start;
+    data.ticks_counter.ticks += ticks;
+    if (elapsed >= 1000) {
+        data.ticks_counter.per_second = data.ticks_counter.ticks * 1000 / elapsed;
+        data.ticks_counter.ticks = 0;
+        data.ticks_counter.start = now;
+    }
+}
+
+int game_speed_get_ticks_per_second(void)
+{
+    return data.ticks_counter.per_second;
+}
@@ -3,4 +3,10 @@
 
 int game_speed_get_elapsed_ticks(void);
 
+int game_speed_get_turbo_frame_millis(void);
+
+void game_speed_count_ticks(int ticks);
+
+int game_speed_get_ticks_per_second(void);
+
 #endif // GAME_SPEED_H
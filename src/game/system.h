@@ -1,6 +1,7 @@
 #ifndef GAME_SYSTEM_H
 #define GAME_SYSTEM_H
 
+#include "core/time.h"
 #include "graphics/color.h"
 #include "input/keys.h"
 
@@ -171,4 +172,67 @@ void system_setup_crash_handler(void);
  */
 void system_exit(void);
 
+/**
+ * A thread created by system_thread_run
+ */
+typedef struct system_thread system_thread;
+
+/**
+ * Runs a function on a new thread
+ * @param function Function to run, its return value is passed to system_thread_wait
+ * @param data Data to pass to the function
+ * @return The new thread, or 0 if no thread could be created
+ */
+system_thread *system_thread_run(int (*function)(void *), void *data);
+
+/**
+ * Waits for a thread to finish and releases it
+ * @param thread Thread to wait for
+ * @return The return value of the thread's function
+ */
+int system_thread_wait(system_thread *thread);
+
+/**
+ * A counting semaphore, to pass work between threads
+ */
+typedef struct system_semaphore system_semaphore;
+
+/**
+ * Creates a semaphore
+ * @param value Initial value
+ * @return The semaphore, or 0 if it could not be created
+ */
+system_semaphore *system_semaphore_create(int value);
+
+/**
+ * Destroys a semaphore
+ * @param semaphore Semaphore to destroy
+ */
+void system_semaphore_destroy(system_semaphore *semaphore);
+
+/**
+ * Waits until the value of a semaphore is above zero and decrements it
+ * @param semaphore Semaphore to wait for
+ */
+void system_semaphore_wait(system_semaphore *semaphore);
+
+/**
+ * Decrements the value of a semaphore if it is above zero, without waiting
+ * @param semaphore Semaphore to decrement
+ * @return 1 if the value was decremented, 0 otherwise
+ */
+int system_semaphore_try_wait(system_semaphore *semaphore);
+
+/**
+ * Increments the value of a semaphore, waking up a thread waiting for it
+ * @param semaphore Semaphore to increment
+ */
+void system_semaphore_post(system_semaphore *semaphore);
+
+/**
+ * Gets the current time. Unlike time_get_millis, this keeps counting during a frame
+ * @return Current time in milliseconds
+ */
+time_millis system_get_millis(void);
+
 #endif // GAME_SYSTEM_H
@@ -19,6 +19,7 @@
 #include "map/building_tiles.h"
 #include "map/grid.h"
 #include "map/image.h"
+#include "map/journal.h"
 #include "map/property.h"
 #include "map/routing_terrain.h"
 #include "map/sprite.h"
@@ -44,11 +45,29 @@ int game_can_undo(void)
     return data.ready && data.available;
 }
 
-void game_undo_disable(void)
+// The building array sees the kept buildings as in use while undo is possible, so they must be let go
+static void release_buildings(void)
 {
+    for (int i = 0; i < MAX_UNDO_BUILDINGS; i++) {
+        if (data.buildings[i].id) {
+            building_release_from_undo(data.buildings[i].id);
+        }
+    }
+}
+
+static void disable(void)
+{
+    if (game_can_undo()) {
+        release_buildings();
+    }
     data.available = 0;
 }
 
+void game_undo_disable(void)
+{
+    disable();
+}
+
 void game_undo_add_building(building *b)
 {
     if (b->id <= 0) {
@@ -72,7 +91,7 @@ void game_undo_add_building(building *b)
                 return;
             }
         }
-        data.available = 0;
+        disable();
     }
 }
 
@@ -110,6 +129,7 @@ static void clear_buildings(void)
 
 int game_undo_start_build(building_type type)
 {
+    disable();
     data.ready = 0;
     data.available = 1;
     data.timeout_ticks = 0;
@@ -127,11 +147,7 @@ int game_undo_start_build(building_type type)
         }
     }
 
-    map_image_backup();
-    map_terrain_backup();
-    map_aqueduct_backup();
-    map_property_backup();
-    map_sprite_backup();
+    map_journal_start();
 
     return 1;
 }
@@ -150,28 +166,13 @@ void game_undo_restore_building_state(void)
     clear_buildings();
 }
 
-static void restore_map_images(void)
-{
-    int map_width, map_height;
-    map_grid_size(&map_width, &map_height);
-    for (int y = 0; y < map_height; y++) {
-        for (int x = 0; x < map_width; x++) {
-            int grid_offset = map_grid_offset(x, y);
-            if (!map_building_at(grid_offset)) {
-                map_image_restore_at(grid_offset);
-            }
-        }
-    }
-}
-
 void game_undo_restore_map(int include_properties)
 {
-    map_terrain_restore();
-    map_aqueduct_restore();
+    int layers = MAP_JOURNAL_TERRAIN | MAP_JOURNAL_AQUEDUCT | MAP_JOURNAL_IMAGE_WITHOUT_BUILDING;
     if (include_properties) {
-        map_property_restore();
+        layers |= MAP_JOURNAL_PROPERTY;
     }
-    restore_map_images();
+    map_journal_restore(layers);
 }
 
 void game_undo_finish_build(int cost)
@@ -218,12 +219,15 @@ void game_undo_perform(void)
     if (!game_can_undo()) {
         return;
     }
-    data.available = 0;
+    disable();
     city_finance_process_construction(-data.building_cost);
     if (data.type == BUILDING_CLEAR_LAND) {
         for (int i = 0; i < data.num_buildings; i++) {
             if (data.buildings[i].id) {
                 building *b = building_restore_from_undo(&data.buildings[i]);
+                if (b->has_plague) {
+                    city_buildings_add_plague(b);
+                }
                 switch (b->type) {
                     default:
                         break;
@@ -265,31 +269,19 @@ void game_undo_perform(void)
                 add_building_to_terrain(b);
             }
         }
-        map_terrain_restore();
-        map_aqueduct_restore();
-        map_sprite_restore();
-        map_image_restore();
-        map_property_restore();
+        map_journal_restore(MAP_JOURNAL_ALL);
         map_property_clear_constructing_and_deleted();
     } else if (data.type == BUILDING_AQUEDUCT || data.type == BUILDING_ROAD ||
         data.type == BUILDING_WALL) {
-        map_terrain_restore();
-        map_aqueduct_restore();
-        restore_map_images();
+        map_journal_restore(MAP_JOURNAL_TERRAIN | MAP_JOURNAL_AQUEDUCT | MAP_JOURNAL_IMAGE_WITHOUT_BUILDING);
     } else if (data.type == BUILDING_LOW_BRIDGE || data.type == BUILDING_SHIP_BRIDGE) {
-        map_terrain_restore();
-        map_sprite_restore();
-        restore_map_images();
+        map_journal_restore(MAP_JOURNAL_TERRAIN | MAP_JOURNAL_SPRITE | MAP_JOURNAL_IMAGE_WITHOUT_BUILDING);
     } else if (data.type == BUILDING_PLAZA || data.type == BUILDING_GARDENS) {
-        map_terrain_restore();
-        map_aqueduct_restore();
-        map_property_restore();
-        restore_map_images();
+        map_journal_restore(MAP_JOURNAL_TERRAIN | MAP_JOURNAL_AQUEDUCT | MAP_JOURNAL_PROPERTY |
+            MAP_JOURNAL_IMAGE_WITHOUT_BUILDING);
     } else if (data.num_buildings) {
         if (data.type == BUILDING_DRAGGABLE_RESERVOIR) {
-            map_terrain_restore();
-            map_aqueduct_restore();
-            restore_map_images();
+            map_journal_restore(MAP_JOURNAL_TERRAIN | MAP_JOURNAL_AQUEDUCT | MAP_JOURNAL_IMAGE_WITHOUT_BUILDING);
         }
         for (int i = 0; i < data.num_buildings; i++) {
             if (data.buildings[i].id) {
@@ -308,7 +300,7 @@ void game_undo_reduce_time_available(void)
         return;
     }
     if (data.timeout_ticks <= 0 || scenario_earthquake_is_in_progress()) {
-        data.available = 0;
+        disable();
         clear_buildings();
         window_invalidate();
         return;
@@ -327,7 +319,7 @@ void game_undo_reduce_time_available(void)
         default: break;
     }
     if (data.num_buildings <= 0) {
-        data.available = 0;
+        disable();
         window_invalidate();
         return;
     }
@@ -335,7 +327,7 @@ void game_undo_reduce_time_available(void)
         for (int i = 0; i < data.num_buildings; i++) {
             if (data.buildings[i].id && building_get(data.buildings[i].id)->house_population) {
                 // no undo on a new house where people moved in
-                data.available = 0;
+                disable();
                 window_invalidate();
                 return;
             }
@@ -347,12 +339,12 @@ void game_undo_reduce_time_available(void)
             if (b->state == BUILDING_STATE_UNDO ||
                 b->state == BUILDING_STATE_RUBBLE ||
                 b->state == BUILDING_STATE_DELETED_BY_GAME) {
-                data.available = 0;
+                disable();
                 window_invalidate();
                 return;
             }
             if (b->type != data.buildings[i].type || b->grid_offset != data.buildings[i].grid_offset) {
-                data.available = 0;
+                disable();
                 window_invalidate();
                 return;
             }
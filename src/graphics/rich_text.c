@@ -9,6 +9,7 @@
 #include "graphics/image_button.h"
 #include "graphics/panel.h"
 #include "graphics/scrollbar.h"
+#include "graphics/text_layout.h"
 #include "graphics/window.h"
 
 #define MAX_LINKS 50
@@ -238,15 +239,13 @@ static void draw_line(const uint8_t *str, int x, int y, color_t color, int measu
     }
 }
 
-static int draw_text(const uint8_t *text, int x_offset, int y_offset,
-                     int box_width, int height_lines, color_t color, int measure_only)
+static int layout_text(text_layout *layout, const uint8_t *text, int box_width, int measure_only)
 {
     int image_height_lines = 0;
     int image_id = 0;
     int lines_before_image = 0;
     int paragraph = 0;
     int has_more_characters = 1;
-    int y = y_offset;
     int guard = 0;
     int line = 0;
     int num_lines = 0;
@@ -315,6 +314,48 @@ static int draw_text(const uint8_t *text, int x_offset, int y_offset,
             }
         }
 
+        int line_image_id = 0;
+        if (!measure_only) {
+            if (image_id) {
+                if (lines_before_image) {
+                    lines_before_image--;
+                } else {
+                    image_height_lines = image_get(image_id)->height / data.line_height + 2;
+                    line_image_id = image_id;
+                    image_id = 0;
+                }
+            }
+        }
+        if (!text_layout_add_line(layout, tmp_line, x_line_offset, line_image_id)) {
+            return 0;
+        }
+        line++;
+        num_lines++;
+    }
+    layout->result = num_lines;
+    return 1;
+}
+
+static int draw_text(const uint8_t *text, int x_offset, int y_offset,
+                     int box_width, int height_lines, color_t color, int measure_only)
+{
+    // the layout does not depend on the scroll position, so it only needs to be calculated once per text
+    int key[TEXT_LAYOUT_KEY_SIZE] = {
+        data.normal_font->font, data.link_font->font, data.line_height, data.paragraph_indent,
+        box_width, measure_only
+    };
+    int is_cached;
+    text_layout *layout = text_layout_get(text, key, &is_cached);
+    if (!layout) {
+        return 0;
+    }
+    if (!is_cached && !layout_text(layout, text, box_width, measure_only)) {
+        text_layout_discard(layout);
+        return 0;
+    }
+    int y = y_offset;
+    for (int line = 0; line < layout->num_lines; line++) {
+        const text_layout_line *current = &layout->lines[line];
         int outside_viewport = 0;
         if (!measure_only) {
             if (line < scrollbar.scroll_position || line >= scrollbar.scroll_position + height_lines) {
@@ -322,36 +363,26 @@ static int draw_text(const uint8_t *text, int x_offset, int y_offset,
             }
         }
         if (!outside_viewport) {
-            draw_line(tmp_line, x_line_offset + x_offset, y, color, measure_only);
+            draw_line(text_layout_line_text(layout, line), current->x_offset + x_offset, y, color, measure_only);
         }
-        if (!measure_only) {
-            if (image_id) {
-                if (lines_before_image) {
-                    lines_before_image--;
+        if (current->image_id) {
+            const image *img = image_get(current->image_id);
+            int image_offset_x = x_offset + (box_width - img->width) / 2 - 4;
+            if (line < height_lines + scrollbar.scroll_position) {
+                if (line >= scrollbar.scroll_position) {
+                    image_draw(current->image_id, image_offset_x, y + 8, COLOR_MASK_NONE, SCALE_NONE);
                 } else {
-                    const image *img = image_get(image_id);
-                    image_height_lines = img->height / data.line_height + 2;
-                    int image_offset_x = x_offset + (box_width - img->width) / 2 - 4;
-                    if (line < height_lines + scrollbar.scroll_position) {
-                        if (line >= scrollbar.scroll_position) {
-                            image_draw(image_id, image_offset_x, y + 8, COLOR_MASK_NONE, SCALE_NONE);
-                        } else {
-                            image_draw(image_id, image_offset_x,
-                                y + 8 - data.line_height * (scrollbar.scroll_position - line),
-                                COLOR_MASK_NONE, SCALE_NONE);
-                        }
-                    }
-                    image_id = 0;
+                    image_draw(current->image_id, image_offset_x,
+                        y + 8 - data.line_height * (scrollbar.scroll_position - line),
+                        COLOR_MASK_NONE, SCALE_NONE);
                 }
             }
         }
-        line++;
-        num_lines++;
         if (!outside_viewport) {
             y += data.line_height;
         }
     }
-    return num_lines;
+    return layout->result;
 }
 
 int rich_text_draw(const uint8_t *text, int x_offset, int y_offset, int box_width, int height_lines, int measure_only)
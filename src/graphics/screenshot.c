@@ -7,6 +7,7 @@
 #include "core/file.h"
 #include "core/log.h"
 #include "core/string.h"
+#include "game/system.h"
 #include "graphics/screen.h"
 #include "graphics/graphics.h"
 #include "graphics/menu.h"
@@ -245,10 +246,35 @@ static void create_window_screenshot(void)
     image_free();
 }
 
-static void create_full_city_screenshot(void)
+static int write_strip(void *canvas)
+{
+    return image_write_rows(canvas, screenshot.width);
+}
+
+static int start_writing_strip(color_t *canvas, system_thread **writer)
+{
+    *writer = system_thread_run(write_strip, canvas);
+    if (*writer) {
+        return 1;
+    }
+    // no thread available: write the strip right away
+    return write_strip(canvas);
+}
+
+static int finish_writing_strip(system_thread **writer)
+{
+    if (!*writer) {
+        return 1;
+    }
+    int result = system_thread_wait(*writer);
+    *writer = 0;
+    return result;
+}
+
+static int create_full_city_screenshot(const char *filename)
 {
     if (!window_is(WINDOW_CITY) && !window_is(WINDOW_CITY_MILITARY)) {
-        return;
+        return 0;
     }
     pixel_offset original_camera_pixels;
     city_view_get_camera_in_pixels(&original_camera_pixels.x, &original_camera_pixels.y);
@@ -258,21 +284,27 @@ static void create_full_city_screenshot(void)
 
     if (!image_create(city_width_pixels, city_height_pixels + TILE_Y_SIZE, 0, IMAGE_HEIGHT_CHUNK)) {
         log_error("Unable to set memory for full city screenshot", 0, 0);
-        return;
+        return 0;
     }
-    const char *filename = generate_filename(SCREENSHOT_FULL_CITY);
     if (!image_begin_io(filename) || !image_write_header()) {
         log_error("Unable to write screenshot to:", filename, 0);
         image_free();
-        return;
+        return 0;
     }
 
-    color_t *canvas = malloc(sizeof(color_t) * city_width_pixels * IMAGE_HEIGHT_CHUNK);
-    if (!canvas) {
+    // one strip is written to the file while the next one is drawn
+    size_t canvas_size = sizeof(color_t) * city_width_pixels * IMAGE_HEIGHT_CHUNK;
+    color_t *canvases[2] = { malloc(canvas_size), malloc(canvas_size) };
+    if (!canvases[0] || !canvases[1]) {
+        free(canvases[0]);
+        free(canvases[1]);
         image_free();
-        return;
+        return 0;
     }
-    memset(canvas, 0, sizeof(color_t) * city_width_pixels * IMAGE_HEIGHT_CHUNK);
+    memset(canvases[0], 0, canvas_size);
+    memset(canvases[1], 0, canvas_size);
+    int current_canvas = 0;
+    system_thread *writer = 0;
 
     int canvas_width = 8 * TILE_X_SIZE;
     int old_scale = city_view_get_scale();
@@ -292,6 +324,7 @@ static void create_full_city_screenshot(void)
         IMAGE_HEIGHT_CHUNK + TOP_MENU_HEIGHT);
     int current_height = base_height;
     while ((size = image_request_rows())) {
+        color_t *canvas = canvases[current_canvas];
         int y_offset = current_height + IMAGE_HEIGHT_CHUNK > max_height ?
             IMAGE_HEIGHT_CHUNK - (max_height - current_height) - TILE_Y_SIZE: 0;
         for (int width = 0; width < city_width_pixels; width += canvas_width) {
@@ -306,24 +339,31 @@ static void create_full_city_screenshot(void)
             graphics_renderer()->save_screen_buffer(&canvas[width], x_offset, TOP_MENU_HEIGHT + y_offset,
                 image_section_width, IMAGE_HEIGHT_CHUNK - y_offset, city_width_pixels);
         }
-        if (!image_write_rows(canvas, city_width_pixels)) {
-            log_error("Error writing image", 0, 0);
+        if (!finish_writing_strip(&writer) || !start_writing_strip(canvas, &writer)) {
             error = 1;
             break;
         }
+        current_canvas = 1 - current_canvas;
         current_height += IMAGE_HEIGHT_CHUNK;
     }
+    if (!finish_writing_strip(&writer)) {
+        error = 1;
+    }
+    free(canvases[0]);
+    free(canvases[1]);
     city_view_set_viewport(viewport_width + (city_view_is_sidebar_collapsed() ? 42 : 162), viewport_height + TOP_MENU_HEIGHT);
     city_view_set_scale(old_scale);
     graphics_reset_clip_rectangle();
     city_view_set_camera_from_pixel_position(original_camera_pixels.x, original_camera_pixels.y);
-    if (!error) {
+    if (error) {
+        log_error("Error writing image", 0, 0);
+    } else {
         image_finish();
         log_info("Saved full city screenshot:", filename, 0);
-        show_saved_notice(filename);
     }
     image_free();
     window_invalidate();
+    return !error;
 }
 
 static void create_minimap_screenshot(void)
@@ -361,6 +401,7 @@ static void create_minimap_screenshot(void)
         log_info("Saved city map screenshot:", filename, 0);
         show_saved_notice(filename);
     }
+    free(canvas);
     image_free();
     window_invalidate();
 }
@@ -368,9 +409,13 @@ static void create_minimap_screenshot(void)
 void graphics_save_screenshot(int screenshot_type)
 {
     switch (screenshot_type) {
-        case SCREENSHOT_FULL_CITY:
-            create_full_city_screenshot();
+        case SCREENSHOT_FULL_CITY: {
+            const char *filename = generate_filename(SCREENSHOT_FULL_CITY);
+            if (create_full_city_screenshot(filename)) {
+                show_saved_notice(filename);
+            }
             return;
+        }
         case SCREENSHOT_DISPLAY:
             create_window_screenshot();
             return;
@@ -379,3 +424,8 @@ void graphics_save_screenshot(int screenshot_type)
             return;
     }
 }
+
+int graphics_save_full_city_screenshot(const char *filename)
+{
+    return create_full_city_screenshot(filename);
+}
@@ -10,4 +10,11 @@ enum {
 
 void graphics_save_screenshot(int screenshot_type);
 
+/**
+ * Saves a picture of the whole city to a file
+ * @param filename File to save the picture to
+ * @return 1 if the picture was saved, 0 otherwise
+ */
+int graphics_save_full_city_screenshot(const char *filename);
+
 #endif // GRAPHICS_SCREENSHOT_H
@@ -7,12 +7,18 @@
 #include "core/time.h"
 #include "graphics/graphics.h"
 #include "graphics/image.h"
+#include "graphics/text_layout.h"
 
 #include <string.h>
 
 #define ELLIPSIS_LENGTH 4
 #define NUMBER_BUFFER_LENGTH 100
 
+#define RUN_CACHE_SIZE 512
+#define RUN_CACHE_BUCKETS 1024
+#define RUN_MAX_LENGTH 64
+#define RUN_TEXT -1
+
 static uint8_t tmp_line[200];
 
 static struct {
@@ -42,6 +48,185 @@ static int get_ellipsis_width(font_t font)
     return ellipsis.width[font];
 }
 
+typedef struct {
+    int letter_id;
+    int16_t x;
+    int16_t y;
+} run_glyph;
+
+typedef struct {
+    uint8_t text[RUN_MAX_LENGTH + 1];
+    int length;
+    font_t font;
+    int separator_pixels;
+    unsigned int hash;
+    int width;
+    int num_glyphs;
+    run_glyph glyphs[RUN_MAX_LENGTH];
+    int next_in_bucket;
+    int prev_used;
+    int next_used;
+} text_run;
+
+static struct {
+    text_run runs[RUN_CACHE_SIZE];
+    int buckets[RUN_CACHE_BUCKETS];
+    int most_recent;
+    int least_recent;
+    int initialized;
+} run_cache;
+
+static void init_run_cache(void)
+{
+    for (int i = 0; i < RUN_CACHE_BUCKETS; i++) {
+        run_cache.buckets[i] = -1;
+    }
+    for (int i = 0; i < RUN_CACHE_SIZE; i++) {
+        text_run *run = &run_cache.runs[i];
+        run->length = -1;
+        run->next_in_bucket = -1;
+        run->prev_used = i - 1;
+        run->next_used = i + 1 < RUN_CACHE_SIZE ? i + 1 : -1;
+    }
+    run_cache.most_recent = 0;
+    run_cache.least_recent = RUN_CACHE_SIZE - 1;
+    run_cache.initialized = 1;
+}
+
+void text_clear_cache(void)
+{
+    init_run_cache();
+    text_layout_clear();
+}
+
+static unsigned int hash_run(const uint8_t *str, int length, font_t font, int separator_pixels)
+{
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++) {
+        hash = (hash ^ str[i]) * 16777619u;
+    }
+    hash = (hash ^ font) * 16777619u;
+    return (hash ^ (separator_pixels + 1)) * 16777619u;
+}
+
+static void mark_run_used(int index)
+{
+    text_run *run = &run_cache.runs[index];
+    if (run_cache.most_recent == index) {
+        return;
+    }
+    run_cache.runs[run->prev_used].next_used = run->next_used;
+    if (run->next_used >= 0) {
+        run_cache.runs[run->next_used].prev_used = run->prev_used;
+    } else {
+        run_cache.least_recent = run->prev_used;
+    }
+    run->prev_used = -1;
+    run->next_used = run_cache.most_recent;
+    run_cache.runs[run_cache.most_recent].prev_used = index;
+    run_cache.most_recent = index;
+}
+
+static void remove_run_from_bucket(int index)
+{
+    text_run *run = &run_cache.runs[index];
+    int *link = &run_cache.buckets[run->hash % RUN_CACHE_BUCKETS];
+    while (*link >= 0) {
+        if (*link == index) {
+            *link = run->next_in_bucket;
+            break;
+        }
+        link = &run_cache.runs[*link].next_in_bucket;
+    }
+    run->next_in_bucket = -1;
+}
+
+static void layout_run(text_run *run)
+{
+    const font_definition *def = font_definition_for(run->font);
+    const uint8_t *str = run->text;
+    int length = run->length;
+    int x = 0;
+    run->num_glyphs = 0;
+    while (length > 0) {
+        int num_bytes = 1;
+        if (*str >= ' ') {
+            int letter_id = font_letter_id(def, str, &num_bytes);
+            int width;
+            if (*str == ' ' || *str == '_' || letter_id < 0) {
+                width = def->space_width;
+            } else {
+                const image *img = image_letter(letter_id);
+                run_glyph *glyph = &run->glyphs[run->num_glyphs++];
+                glyph->letter_id = letter_id;
+                glyph->x = x;
+                glyph->y = def->image_y_offset(*str, img->height + img->y_offset, def->line_height);
+                if (run->separator_pixels == RUN_TEXT) {
+                    width = def->letter_spacing + img->original.width;
+                } else {
+                    width = def->letter_spacing + img->width;
+                }
+            }
+            x += width;
+            if (run->separator_pixels != RUN_TEXT && (length == 4 || length == 7)) {
+                x += run->separator_pixels;
+            }
+        }
+        str += num_bytes;
+        length -= num_bytes;
+    }
+    run->width = x;
+}
+
+/**
+ * Gets the glyph positions for a string, laying them out when the string was not drawn recently
+ * @param separator_pixels Pixels to add between thousands for numbers, or RUN_TEXT for regular text
+ * @return The cached run, or 0 if the string is too long to cache
+ */
+static const text_run *get_run(const uint8_t *str, int length, font_t font, int separator_pixels)
+{
+    if (length > RUN_MAX_LENGTH) {
+        return 0;
+    }
+    if (!run_cache.initialized) {
+        init_run_cache();
+    }
+    unsigned int hash = hash_run(str, length, font, separator_pixels);
+    int *bucket = &run_cache.buckets[hash % RUN_CACHE_BUCKETS];
+    for (int index = *bucket; index >= 0; index = run_cache.runs[index].next_in_bucket) {
+        text_run *run = &run_cache.runs[index];
+        if (run->hash == hash && run->length == length && run->font == font &&
+            run->separator_pixels == separator_pixels && memcmp(run->text, str, length) == 0) {
+            mark_run_used(index);
+            return run;
+        }
+    }
+    int index = run_cache.least_recent;
+    text_run *run = &run_cache.runs[index];
+    if (run->length >= 0) {
+        remove_run_from_bucket(index);
+    }
+    memcpy(run->text, str, length);
+    run->text[length] = 0;
+    run->length = length;
+    run->font = font;
+    run->separator_pixels = separator_pixels;
+    run->hash = hash;
+    layout_run(run);
+    run->next_in_bucket = *bucket;
+    *bucket = index;
+    mark_run_used(index);
+    return run;
+}
+
+static void draw_run(const text_run *run, int x, int y, color_t color, float scale)
+{
+    for (int i = 0; i < run->num_glyphs; i++) {
+        const run_glyph *glyph = &run->glyphs[i];
+        image_draw_letter(run->font, glyph->letter_id, x + glyph->x, y - glyph->y, color, scale);
+    }
+}
+
 void text_capture_cursor(int cursor_position, int offset_start, int offset_end)
 {
     input_cursor.capture = 1;
@@ -314,7 +499,13 @@ int text_draw_scaled(const uint8_t *str, int x, int y, font_t font, color_t colo
     const font_definition *def = font_definition_for(font);
 
     int length = string_length(str);
-    if (input_cursor.capture) {
+    if (!input_cursor.capture) {
+        const text_run *run = get_run(str, length, font, RUN_TEXT);
+        if (run) {
+            draw_run(run, x, y, color, scale);
+            return run->width + def->space_width;
+        }
+    } else {
         str += input_cursor.text_offset_start;
         length = input_cursor.text_offset_end - input_cursor.text_offset_start;
     }
@@ -390,31 +581,12 @@ int text_draw_number_scaled(int value, char prefix, const char *postfix,
 
     uint8_t buffer[NUMBER_BUFFER_LENGTH];
     int length = string_from_int(buffer, value, 0);
-    uint8_t *str = buffer;
 
     int separator_pixels = config_get(CONFIG_UI_DIGIT_SEPARATOR) * 3;
 
-    while (length > 0) {
-        int num_bytes = 1;
-
-        if (*str >= ' ') {
-            int letter_id = font_letter_id(def, str, &num_bytes);
-            int width;
-            if (*str == ' ' || *str == '_' || letter_id < 0) {
-                width = def->space_width;
-            } else {
-                const image *img = image_letter(letter_id);
-                int height = def->image_y_offset(*str, img->height + img->y_offset, def->line_height);
-                image_draw_letter(def->font, letter_id, current_x, y - height, color, scale);
-                width = def->letter_spacing + img->width;
-            }
-
-            current_x += width + ((length == 4 || length == 7) ? separator_pixels : 0);
-        }
-
-        str += num_bytes;
-        length -= num_bytes;
-    }
+    const text_run *run = get_run(buffer, length, font, separator_pixels);
+    draw_run(run, current_x, y, color, scale);
+    current_x += run->width;
 
     if (postfix && *postfix) {
         current_x += text_draw_scaled(string_from_ascii(postfix), current_x, y, font, color, scale);
@@ -563,15 +735,10 @@ void text_draw_number_centered_colored(
     text_draw_centered(str, x_offset, y_offset, box_width, font, color);
 }
 
-int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_width, font_t font, uint32_t color)
+static int layout_multiline(text_layout *layout, const uint8_t *str, int box_width, font_t font)
 {
-    int line_height = font_definition_for(font)->line_height;
-    if (line_height < 11) {
-        line_height = 11;
-    }
     int has_more_characters = 1;
     int guard = 0;
-    int y = y_offset;
     while (has_more_characters) {
         if (++guard >= 100) {
             break;
@@ -606,7 +773,39 @@ int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_
                 }
             }
         }
-        text_draw(tmp_line, x_offset, y, font, color);
+        if (!text_layout_add_line(layout, tmp_line, 0, 0)) {
+            return 0;
+        }
+    }
+    layout->result = layout->num_lines;
+    return 1;
+}
+
+static const text_layout *get_multiline_layout(const uint8_t *str, int box_width, font_t font)
+{
+    int key[TEXT_LAYOUT_KEY_SIZE] = { -1, font, box_width };
+    int is_cached;
+    text_layout *layout = text_layout_get(str, key, &is_cached);
+    if (layout && !is_cached && !layout_multiline(layout, str, box_width, font)) {
+        text_layout_discard(layout);
+        return 0;
+    }
+    return layout;
+}
+
+int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_width, font_t font, uint32_t color)
+{
+    int line_height = font_definition_for(font)->line_height;
+    if (line_height < 11) {
+        line_height = 11;
+    }
+    const text_layout *layout = get_multiline_layout(str, box_width, font);
+    if (!layout) {
+        return 0;
+    }
+    int y = y_offset;
+    for (int i = 0; i < layout->num_lines; i++) {
+        text_draw(text_layout_line_text(layout, i), x_offset, y, font, color);
         y += line_height + 5;
     }
     return y - y_offset;
@@ -614,33 +813,6 @@ int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_
 
 int text_measure_multiline(const uint8_t *str, int box_width, font_t font)
 {
-    int has_more_characters = 1;
-    int guard = 0;
-    int num_lines = 0;
-    while (has_more_characters) {
-        if (++guard >= 100) {
-            break;
-        }
-        int current_width = 0;
-        while (has_more_characters && current_width < box_width) {
-            int word_num_chars;
-            int word_width = get_word_width(str, font, &word_num_chars);
-            current_width += word_width;
-            if (current_width >= box_width) {
-                if (current_width == 0) {
-                    has_more_characters = 0;
-                }
-            } else {
-                str += word_num_chars;
-                if (!*str) {
-                    has_more_characters = 0;
-                } else if (*str == '\n') {
-                    str++;
-                    break;
-                }
-            }
-        }
-        num_lines += 1;
-    }
-    return num_lines;
+    const text_layout *layout = get_multiline_layout(str, box_width, font);
+    return layout ? layout->num_lines : 0;
 }
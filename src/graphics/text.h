@@ -7,6 +7,11 @@
 
 #include <stdint.h>
 
+/**
+ * Clears the cached glyph positions and line breaks. Needs to be called when the fonts change
+ */
+void text_clear_cache(void);
+
 void text_capture_cursor(int cursor_position, int offset_start, int offset_end);
 void text_draw_cursor(int x_offset, int y_offset, int is_insert);
 
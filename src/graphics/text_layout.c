@@ -0,0 +1,113 @@
+#include "text_layout.h"
+
+#include "core/log.h"
+#include "core/string.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_LAYOUTS 8
+
+static struct {
+    text_layout layouts[MAX_LAYOUTS];
+    unsigned int usage;
+} data;
+
+static int matches(const text_layout *layout, const uint8_t *text, int length, const int *key)
+{
+    return layout->last_used && layout->text_length == length &&
+        memcmp(layout->key, key, sizeof(layout->key)) == 0 &&
+        memcmp(layout->text, text, length) == 0;
+}
+
+static void reset_layout(text_layout *layout)
+{
+    layout->text_length = 0;
+    layout->num_lines = 0;
+    layout->line_text_size = 0;
+    layout->result = 0;
+    layout->last_used = 0;
+}
+
+text_layout *text_layout_get(const uint8_t *text, const int key[TEXT_LAYOUT_KEY_SIZE], int *is_cached)
+{
+    int length = string_length(text);
+    text_layout *oldest = &data.layouts[0];
+    for (int i = 0; i < MAX_LAYOUTS; i++) {
+        text_layout *layout = &data.layouts[i];
+        if (matches(layout, text, length, key)) {
+            layout->last_used = ++data.usage;
+            *is_cached = 1;
+            return layout;
+        }
+        if (layout->last_used < oldest->last_used) {
+            oldest = layout;
+        }
+    }
+    *is_cached = 0;
+    reset_layout(oldest);
+    uint8_t *copy = realloc(oldest->text, length + 1);
+    if (!copy) {
+        log_error("Unable to allocate memory for the text layout", 0, 0);
+        return 0;
+    }
+    memcpy(copy, text, length + 1);
+    oldest->text = copy;
+    oldest->text_length = length;
+    memcpy(oldest->key, key, sizeof(oldest->key));
+    oldest->last_used = ++data.usage;
+    return oldest;
+}
+
+int text_layout_add_line(text_layout *layout, const uint8_t *line, int x_offset, int image_id)
+{
+    if (layout->num_lines >= layout->lines_capacity) {
+        int capacity = layout->lines_capacity ? layout->lines_capacity * 2 : 32;
+        text_layout_line *lines = realloc(layout->lines, capacity * sizeof(text_layout_line));
+        if (!lines) {
+            log_error("Unable to allocate memory for the text layout", 0, 0);
+            return 0;
+        }
+        layout->lines = lines;
+        layout->lines_capacity = capacity;
+    }
+    int length = string_length(line) + 1;
+    if (layout->line_text_size + length > layout->line_text_capacity) {
+        int capacity = layout->line_text_capacity ? layout->line_text_capacity : 1024;
+        while (capacity < layout->line_text_size + length) {
+            capacity *= 2;
+        }
+        uint8_t *line_text = realloc(layout->line_text, capacity);
+        if (!line_text) {
+            log_error("Unable to allocate memory for the text layout", 0, 0);
+            return 0;
+        }
+        layout->line_text = line_text;
+        layout->line_text_capacity = capacity;
+    }
+    text_layout_line *current = &layout->lines[layout->num_lines++];
+    current->text_offset = layout->line_text_size;
+    current->x_offset = x_offset;
+    current->image_id = image_id;
+    memcpy(&layout->line_text[layout->line_text_size], line, length);
+    layout->line_text_size += length;
+    return 1;
+}
+
+void text_layout_discard(text_layout *layout)
+{
+    reset_layout(layout);
+}
+
+const uint8_t *text_layout_line_text(const text_layout *layout, int index)
+{
+    return &layout->line_text[layout->lines[index].text_offset];
+}
+
+void text_layout_clear(void)
+{
+    for (int i = 0; i < MAX_LAYOUTS; i++) {
+        reset_layout(&data.layouts[i]);
+    }
+    data.usage = 0;
+}
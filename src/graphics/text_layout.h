@@ -0,0 +1,74 @@
+#ifndef GRAPHICS_TEXT_LAYOUT_H
+#define GRAPHICS_TEXT_LAYOUT_H
+
+#include <stdint.h>
+
+/**
+ * @file
+ * Cache for the line breaking of multi-line texts.
+ * Breaking a text into lines measures every word of it, which is too expensive to redo on every frame
+ * for texts that do not change while their window is open.
+ */
+
+#define TEXT_LAYOUT_KEY_SIZE 6
+
+typedef struct {
+    int text_offset;
+    int x_offset;
+    int image_id;
+} text_layout_line;
+
+typedef struct {
+    int key[TEXT_LAYOUT_KEY_SIZE];
+    uint8_t *text;
+    int text_length;
+    text_layout_line *lines;
+    int num_lines;
+    int lines_capacity;
+    uint8_t *line_text;
+    int line_text_size;
+    int line_text_capacity;
+    int result;
+    unsigned int last_used;
+} text_layout;
+
+/**
+ * Finds the layout of a text. If it is not cached, the least recently used layout is reset to the text
+ * and returned without lines, for the caller to fill in
+ * @param text Text to lay out
+ * @param key Parameters that change the layout, such as the fonts and box width
+ * @param is_cached Out: whether the layout already contains the lines of the text
+ * @return Layout for the text, or 0 when out of memory
+ */
+text_layout *text_layout_get(const uint8_t *text, const int key[TEXT_LAYOUT_KEY_SIZE], int *is_cached);
+
+/**
+ * Adds a line to a layout returned by text_layout_get
+ * @param layout Layout
+ * @param line Text of the line
+ * @param x_offset Horizontal offset of the line
+ * @param image_id Image to draw after the line, or 0 for none
+ * @return 1 if the line was added, 0 when out of memory
+ */
+int text_layout_add_line(text_layout *layout, const uint8_t *line, int x_offset, int image_id);
+
+/**
+ * Marks a layout as invalid, for example because it could not be completed
+ * @param layout Layout
+ */
+void text_layout_discard(text_layout *layout);
+
+/**
+ * Gets the text of a line
+ * @param layout Layout
+ * @param index Line index
+ * @return Null-terminated line text
+ */
+const uint8_t *text_layout_line_text(const text_layout *layout, int index);
+
+/**
+ * Clears all cached layouts. Needs to be called when the fonts change
+ */
+void text_layout_clear(void);
+
+#endif // GRAPHICS_TEXT_LAYOUT_H
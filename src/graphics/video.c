@@ -3,6 +3,7 @@
 #include "core/config.h"
 #include "core/dir.h"
 #include "core/file.h"
+#include "core/log.h"
 #include "core/smacker.h"
 #include "core/time.h"
 #include "game/settings.h"
@@ -15,14 +16,34 @@
 
 #include "pl_mpeg/pl_mpeg.h"
 
+#include <stdlib.h>
 #include <string.h>
 
+#define FRAME_QUEUE_SIZE 4
+
 typedef enum {
     VIDEO_TYPE_NONE = 0,
     VIDEO_TYPE_SMK = 1,
     VIDEO_TYPE_MPG = 2
 } video_type;
 
+typedef struct {
+    int is_last;
+    int has_image;
+    int64_t time_micros;
+    color_t *pixels;
+    struct {
+        uint8_t *data;
+        int width;
+        int size;
+    } planes[3];
+    struct {
+        uint8_t *data;
+        int size;
+        int capacity;
+    } audio;
+} video_frame;
+
 static struct {
     int is_playing;
     int is_ended;
@@ -39,7 +60,7 @@ static struct {
         int micros_per_frame;
         time_millis start_render_millis;
         int current_frame;
-        int draw_frame;
+        int is_yuv;
         plm_frame_t *mpg_frame;
     } video;
     struct {
@@ -52,6 +73,23 @@ static struct {
         color_t *pixels;
         int width;
     } buffer;
+    // frames are decoded on a worker thread into a ring that the render thread plays from
+    struct {
+        video_frame frames[FRAME_QUEUE_SIZE];
+        int read_index;
+        int write_index;
+        int has_next_frame;
+        int stop;
+        system_thread *thread;
+        system_semaphore *free_frames;
+        system_semaphore *decoded_frames;
+        video_frame *current;
+    } queue;
+    struct {
+        int shown;
+        int dropped;
+        int empty_queue;
+    } stats;
     int restart_music;
 } data;
 
@@ -69,15 +107,30 @@ static void close_decoder(void)
     data.type = VIDEO_TYPE_NONE;
 }
 
+static int add_frame_audio(video_frame *frame, const void *audio_data, int len)
+{
+    if (frame->audio.size + len > frame->audio.capacity) {
+        int capacity = frame->audio.size + len;
+        uint8_t *audio = realloc(frame->audio.data, capacity);
+        if (!audio) {
+            return 0;
+        }
+        frame->audio.data = audio;
+        frame->audio.capacity = capacity;
+    }
+    memcpy(&frame->audio.data[frame->audio.size], audio_data, len);
+    frame->audio.size += len;
+    return 1;
+}
+
 static void update_mpg_video(plm_t *plm, plm_frame_t *frame, void *user)
 {
-	data.video.draw_frame = 1;
     data.video.mpg_frame = frame;
 }
 
 static void update_mpg_audio(plm_t *mpeg, plm_samples_t *samples, void *user)
 {
-    sound_device_write_custom_music_data(samples->interleaved, sizeof(float) * samples->count * 2);
+    add_frame_audio(data.queue.current, samples->interleaved, sizeof(float) * samples->count * 2);
 }
 
 static int load_mpg(const char *filename)
@@ -186,6 +239,215 @@ static void end_video(void)
     graphics_renderer()->release_custom_image_buffer(CUSTOM_IMAGE_VIDEO);
 }
 
+static int copy_plane(video_frame *frame, int index, const plm_plane_t *plane)
+{
+    int size = plane->width * plane->height;
+    if (frame->planes[index].size != size) {
+        uint8_t *plane_data = realloc(frame->planes[index].data, size);
+        if (!plane_data) {
+            return 0;
+        }
+        frame->planes[index].data = plane_data;
+        frame->planes[index].size = size;
+    }
+    frame->planes[index].width = plane->width;
+    memcpy(frame->planes[index].data, plane->data, size);
+    return 1;
+}
+
+static int reserve_pixels(video_frame *frame)
+{
+    if (!frame->pixels) {
+        frame->pixels = malloc(sizeof(color_t) * data.video.width * data.video.height);
+    }
+    return frame->pixels != 0;
+}
+
+static int decode_smk_frame(video_frame *frame)
+{
+    frame->time_micros = (int64_t) data.video.current_frame * data.video.micros_per_frame;
+    // the first frame is decoded when opening the file and its audio is played by video_init
+    if (data.video.current_frame > 0) {
+        if (smacker_next_frame(data.s) != SMACKER_FRAME_OK) {
+            return 0;
+        }
+        if (data.audio.has_audio) {
+            int audio_len = smacker_get_frame_audio_size(data.s, 0);
+            const void *audio_data = smacker_get_frame_audio(data.s, 0);
+            if (audio_len > 0 && !add_frame_audio(frame, audio_data, audio_len)) {
+                return 0;
+            }
+        }
+    }
+    data.video.current_frame++;
+
+    const unsigned char *video = smacker_get_frame_video(data.s);
+    const uint32_t *pal = smacker_get_frame_palette(data.s);
+    if (!video || !pal) {
+        return 1;
+    }
+    if (!reserve_pixels(frame)) {
+        return 0;
+    }
+    for (int y = 0; y < data.video.height; y++) {
+        color_t *pixel = &frame->pixels[y * data.video.width];
+        int video_y = data.video.y_scale == SMACKER_Y_SCALE_NONE ? y : y / 2;
+        const unsigned char *line = video + (video_y * data.video.width);
+        for (int x = 0; x < data.video.width; x++) {
+            *pixel = ALPHA_OPAQUE | pal[line[x]];
+            ++pixel;
+        }
+    }
+    frame->has_image = 1;
+    return 1;
+}
+
+static int decode_mpg_frame(video_frame *frame)
+{
+    data.video.mpg_frame = 0;
+    while (!data.video.mpg_frame) {
+        double time = plm_get_time(data.plm);
+        frame->time_micros = (int64_t) (time * 1000000);
+        plm_decode(data.plm, data.video.micros_per_frame / 1000000.0);
+        if (plm_has_ended(data.plm) || (!data.video.mpg_frame && plm_get_time(data.plm) == time)) {
+            return 0;
+        }
+    }
+    plm_frame_t *mpg_frame = data.video.mpg_frame;
+    frame->time_micros = (int64_t) (mpg_frame->time * 1000000);
+    if (data.video.is_yuv) {
+        if (!copy_plane(frame, 0, &mpg_frame->y) || !copy_plane(frame, 1, &mpg_frame->cb) ||
+            !copy_plane(frame, 2, &mpg_frame->cr)) {
+            return 0;
+        }
+    } else {
+        if (!reserve_pixels(frame)) {
+            return 0;
+        }
+        plm_frame_to_bgra(mpg_frame, (uint8_t *) frame->pixels, data.video.width * 4);
+    }
+    frame->has_image = 1;
+    return 1;
+}
+
+static int decode_next_frame(void)
+{
+    video_frame *frame = &data.queue.frames[data.queue.write_index];
+    data.queue.write_index = (data.queue.write_index + 1) % FRAME_QUEUE_SIZE;
+    frame->has_image = 0;
+    frame->audio.size = 0;
+    data.queue.current = frame;
+    int decoded = data.type == VIDEO_TYPE_SMK ? decode_smk_frame(frame) : decode_mpg_frame(frame);
+    frame->is_last = !decoded;
+    return frame->is_last;
+}
+
+static int decode_frames(void *unused)
+{
+    while (1) {
+        system_semaphore_wait(data.queue.free_frames);
+        if (data.queue.stop) {
+            break;
+        }
+        int is_last = decode_next_frame();
+        system_semaphore_post(data.queue.decoded_frames);
+        if (is_last) {
+            break;
+        }
+    }
+    return 0;
+}
+
+static void decode_frames_without_thread(void)
+{
+    if (data.queue.stop) {
+        return;
+    }
+    while (system_semaphore_try_wait(data.queue.free_frames)) {
+        int is_last = decode_next_frame();
+        system_semaphore_post(data.queue.decoded_frames);
+        if (is_last) {
+            data.queue.stop = 1;
+            return;
+        }
+    }
+}
+
+static void free_frames(void)
+{
+    for (int i = 0; i < FRAME_QUEUE_SIZE; i++) {
+        video_frame *frame = &data.queue.frames[i];
+        free(frame->pixels);
+        for (int p = 0; p < 3; p++) {
+            free(frame->planes[p].data);
+        }
+        free(frame->audio.data);
+    }
+    memset(data.queue.frames, 0, sizeof(data.queue.frames));
+}
+
+static void stop_decoder(void)
+{
+    if (!data.queue.free_frames) {
+        return;
+    }
+    if (data.queue.thread) {
+        data.queue.stop = 1;
+        system_semaphore_post(data.queue.free_frames);
+        system_thread_wait(data.queue.thread);
+        data.queue.thread = 0;
+    }
+    system_semaphore_destroy(data.queue.free_frames);
+    system_semaphore_destroy(data.queue.decoded_frames);
+    data.queue.free_frames = 0;
+    data.queue.decoded_frames = 0;
+    free_frames();
+    log_info("Video frames shown:", 0, data.stats.shown);
+    log_info("Video frames dropped:", 0, data.stats.dropped);
+    log_info("Video draws with no decoded frame waiting:", 0, data.stats.empty_queue);
+}
+
+static int start_decoder(void)
+{
+    data.queue.read_index = 0;
+    data.queue.write_index = 0;
+    data.queue.has_next_frame = 0;
+    data.queue.stop = 0;
+    memset(&data.stats, 0, sizeof(data.stats));
+    data.queue.free_frames = system_semaphore_create(FRAME_QUEUE_SIZE);
+    data.queue.decoded_frames = system_semaphore_create(0);
+    if (!data.queue.free_frames || !data.queue.decoded_frames) {
+        log_error("Unable to create the video frame queue", 0, 0);
+        if (data.queue.free_frames) {
+            system_semaphore_destroy(data.queue.free_frames);
+            data.queue.free_frames = 0;
+        }
+        if (data.queue.decoded_frames) {
+            system_semaphore_destroy(data.queue.decoded_frames);
+            data.queue.decoded_frames = 0;
+        }
+        return 0;
+    }
+    data.queue.thread = system_thread_run(decode_frames, 0);
+    if (data.queue.thread) {
+        // wait for the first frame so that it is shown right away
+        system_semaphore_wait(data.queue.decoded_frames);
+        data.queue.has_next_frame = 1;
+    } else {
+        log_info("Unable to create the video decoding thread, decoding while drawing", 0, 0);
+    }
+    return 1;
+}
+
+static void finish_video(void)
+{
+    stop_decoder();
+    close_decoder();
+    data.is_ended = 1;
+    data.is_playing = 0;
+    end_video();
+}
+
 int video_start(const char *filename)
 {
     data.is_playing = 0;
@@ -194,9 +456,10 @@ int video_start(const char *filename)
     if (load_mpg(filename) || load_smk(filename)) {
         sound_music_stop();
         sound_speech_stop();
-        int is_yuv = data.type == VIDEO_TYPE_MPG && graphics_renderer()->supports_yuv_image_format();
-        graphics_renderer()->create_custom_image(CUSTOM_IMAGE_VIDEO, data.video.width, data.video.height, is_yuv);
-        if (!is_yuv) {
+        data.video.is_yuv = data.type == VIDEO_TYPE_MPG && graphics_renderer()->supports_yuv_image_format();
+        graphics_renderer()->create_custom_image(CUSTOM_IMAGE_VIDEO, data.video.width, data.video.height,
+            data.video.is_yuv);
+        if (!data.video.is_yuv) {
             data.buffer.pixels = graphics_renderer()->get_custom_image_buffer(CUSTOM_IMAGE_VIDEO, &data.buffer.width);
         }
         data.is_playing = 1;
@@ -233,6 +496,9 @@ void video_init(int restart_music)
                 audio_data, audio_len);
         }
     }
+    if (data.is_playing && !start_decoder()) {
+        finish_video();
+    }
 }
 
 int video_is_finished(void)
@@ -246,6 +512,7 @@ void video_stop(void)
         if (!data.is_ended) {
             end_video();
         }
+        stop_decoder();
         close_decoder();
         data.is_playing = 0;
     }
@@ -254,91 +521,79 @@ void video_stop(void)
 void video_shutdown(void)
 {
     if (data.is_playing) {
+        stop_decoder();
         close_decoder();
         data.is_playing = 0;
     }
 }
 
-static void get_next_frame(void)
+static void show_frame(const video_frame *frame)
 {
-    if (data.type == VIDEO_TYPE_NONE || (data.type == VIDEO_TYPE_SMK && !data.s) ||
-        (data.type == VIDEO_TYPE_MPG && !data.plm)) {
-        return;
-    }
-    time_millis now_millis = time_get_millis();
-
-    if (data.type == VIDEO_TYPE_SMK) {
-        int frame_no = (now_millis - data.video.start_render_millis) * 1000 / data.video.micros_per_frame;
-        data.video.draw_frame = data.video.current_frame == 0;
-        while (frame_no > data.video.current_frame) {
-            if (smacker_next_frame(data.s) != SMACKER_FRAME_OK) {
-                close_decoder();
-                data.is_ended = 1;
-                data.is_playing = 0;
-                end_video();
-                return;
-            }
-            data.video.current_frame++;
-            data.video.draw_frame = 1;
-
-            if (data.audio.has_audio) {
-                int audio_len = smacker_get_frame_audio_size(data.s, 0);
-                const void *audio_data = smacker_get_frame_audio(data.s, 0);
-                if (audio_len > 0) {
-                    sound_device_write_custom_music_data(audio_data, audio_len);
-                }
-            }
-        }
+    if (data.video.is_yuv) {
+        graphics_renderer()->update_custom_image_yuv(CUSTOM_IMAGE_VIDEO,
+            frame->planes[0].data, frame->planes[0].width, frame->planes[1].data, frame->planes[1].width,
+            frame->planes[2].data, frame->planes[2].width);
     } else {
-        plm_decode(data.plm, (now_millis - data.video.start_render_millis + 1) / 1000.0);
-        data.video.start_render_millis = now_millis;
-        if (plm_has_ended(data.plm)) {
-            close_decoder();
-            data.is_ended = 1;
-            data.is_playing = 0;
-            end_video();
+        for (int y = 0; y < data.video.height; y++) {
+            memcpy(&data.buffer.pixels[y * data.buffer.width], &frame->pixels[y * data.video.width],
+                sizeof(color_t) * data.video.width);
         }
+        graphics_renderer()->update_custom_image(CUSTOM_IMAGE_VIDEO);
     }
+    data.stats.shown++;
 }
 
-static void update_video_frame(void)
+static void play_frames(void)
 {
-    if (data.type == VIDEO_TYPE_NONE) {
+    if (!data.queue.free_frames) {
         return;
     }
-    if (data.type == VIDEO_TYPE_SMK) {
-        const unsigned char *frame = smacker_get_frame_video(data.s);
-        const uint32_t *pal = smacker_get_frame_palette(data.s);
-        if (frame && pal) {
-            for (int y = 0; y < data.video.height; y++) {
-                color_t *pixel = &data.buffer.pixels[y * data.buffer.width];
-                int video_y = data.video.y_scale == SMACKER_Y_SCALE_NONE ? y : y / 2;
-                const unsigned char *line = frame + (video_y * data.video.width);
-                for (int x = 0; x < data.video.width; x++) {
-                    *pixel = ALPHA_OPAQUE | pal[line[x]];
-                    ++pixel;
-                }
-            }
+    if (!data.queue.thread) {
+        decode_frames_without_thread();
+    }
+    int64_t elapsed_micros = (int64_t) (time_get_millis() - data.video.start_render_millis) * 1000;
+
+    // all frames that are due are taken from the queue, only the last one is shown
+    const video_frame *frame_to_show = 0;
+    int frames_taken = 0;
+    while (data.queue.has_next_frame || system_semaphore_try_wait(data.queue.decoded_frames)) {
+        data.queue.has_next_frame = 1;
+        const video_frame *frame = &data.queue.frames[data.queue.read_index];
+        if (frame->time_micros > elapsed_micros) {
+            break;
+        }
+        data.queue.has_next_frame = 0;
+        data.queue.read_index = (data.queue.read_index + 1) % FRAME_QUEUE_SIZE;
+        frames_taken++;
+        if (data.audio.has_audio && frame->audio.size > 0) {
+            sound_device_write_custom_music_data(frame->audio.data, frame->audio.size);
         }
-    } else if (data.type == VIDEO_TYPE_MPG) {
-        if (graphics_renderer()->supports_yuv_image_format()) {
-            plm_frame_t *frame = data.video.mpg_frame;
-            graphics_renderer()->update_custom_image_yuv(CUSTOM_IMAGE_VIDEO, frame->y.data, frame->y.width,
-                frame->cb.data, frame->cb.width, frame->cr.data, frame->cr.width);
+        if (frame->is_last) {
+            finish_video();
             return;
         }
-        plm_frame_to_bgra(data.video.mpg_frame, (uint8_t *) data.buffer.pixels, data.buffer.width * 4);
+        if (frame->has_image) {
+            if (frame_to_show) {
+                data.stats.dropped++;
+            }
+            frame_to_show = frame;
+        }
+    }
+    if (!data.queue.has_next_frame) {
+        data.stats.empty_queue++;
+    }
+    if (frame_to_show) {
+        show_frame(frame_to_show);
+    }
+    // the frames are only handed back to the decoder after they have been shown
+    for (int i = 0; i < frames_taken; i++) {
+        system_semaphore_post(data.queue.free_frames);
     }
-    graphics_renderer()->update_custom_image(CUSTOM_IMAGE_VIDEO);
 }
 
 void video_draw(int x_offset, int y_offset)
 {
-    get_next_frame();
-    if (data.video.draw_frame) {
-        update_video_frame();
-        data.video.draw_frame = 0;
-    }
+    play_frames();
     graphics_renderer()->draw_custom_image(CUSTOM_IMAGE_VIDEO, x_offset, y_offset, 1.0f, 0);
 }
 
@@ -349,10 +604,7 @@ void video_draw_fullscreen(void)
     } else {
         system_show_cursor();
     }
-    get_next_frame();
-    if (data.video.draw_frame) {
-        update_video_frame();
-    }
+    play_frames();
 
     int s_width = screen_width();
     int s_height = screen_height();
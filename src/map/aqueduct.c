@@ -1,6 +1,7 @@
 #include "aqueduct.h"
 
 #include "map/grid.h"
+#include "map/journal.h"
 
 /**
  * The aqueduct grid is used in two ways:
@@ -9,6 +10,7 @@
  * This leads to some strange results
  */
 static grid_u8 aqueduct;
+// only used to keep the backup of the savegame, undo uses map/journal.c
 static grid_u8 aqueduct_backup;
 
 int map_aqueduct_at(int grid_offset)
@@ -18,23 +20,24 @@ int map_aqueduct_at(int grid_offset)
 
 void map_aqueduct_set(int grid_offset, int value)
 {
+    map_journal_record(grid_offset);
     aqueduct.items[grid_offset] = value;
 }
 
 void map_aqueduct_remove(int grid_offset)
 {
-    aqueduct.items[grid_offset] = 0;
+    map_aqueduct_set(grid_offset, 0);
     if (aqueduct.items[grid_offset + map_grid_delta(0, -1)] == 5) {
-        aqueduct.items[grid_offset + map_grid_delta(0, -1)] = 1;
+        map_aqueduct_set(grid_offset + map_grid_delta(0, -1), 1);
     }
     if (aqueduct.items[grid_offset + map_grid_delta(1, 0)] == 6) {
-        aqueduct.items[grid_offset + map_grid_delta(1, 0)] = 2;
+        map_aqueduct_set(grid_offset + map_grid_delta(1, 0), 2);
     }
     if (aqueduct.items[grid_offset + map_grid_delta(0, 1)] == 5) {
-        aqueduct.items[grid_offset + map_grid_delta(0, 1)] = 3;
+        map_aqueduct_set(grid_offset + map_grid_delta(0, 1), 3);
     }
     if (aqueduct.items[grid_offset + map_grid_delta(-1, 0)] == 6) {
-        aqueduct.items[grid_offset + map_grid_delta(-1, 0)] = 4;
+        map_aqueduct_set(grid_offset + map_grid_delta(-1, 0), 4);
     }
 }
 
@@ -43,19 +46,13 @@ void map_aqueduct_clear(void)
     map_grid_clear_u8(aqueduct.items);
 }
 
-void map_aqueduct_backup(void)
-{
-    map_grid_copy_u8(aqueduct.items, aqueduct_backup.items);
-}
-
-void map_aqueduct_restore(void)
-{
-    map_grid_copy_u8(aqueduct_backup.items, aqueduct.items);
-}
-
 void map_aqueduct_save_state(buffer *buf, buffer *backup)
 {
     map_grid_save_state_u8(aqueduct.items, buf);
+    if (map_journal_is_recording()) {
+        map_grid_copy_u8(aqueduct.items, aqueduct_backup.items);
+        map_journal_fill_aqueduct_backup(aqueduct_backup.items);
+    }
     map_grid_save_state_u8(aqueduct_backup.items, backup);
 }
 
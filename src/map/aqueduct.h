@@ -15,10 +15,6 @@ void map_aqueduct_remove(int grid_offset);
 
 void map_aqueduct_clear(void);
 
-void map_aqueduct_backup(void);
-
-void map_aqueduct_restore(void);
-
 void map_aqueduct_save_state(buffer *buf, buffer *backup);
 
 void map_aqueduct_load_state(buffer *buf, buffer *backup);
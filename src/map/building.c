@@ -4,16 +4,11 @@
 #include "core/config.h"
 #include "map/grid.h"
 
-static grid_u16 buildings_grid;
+grid_u16 map_buildings_grid;
 static grid_u8 damage_grid;
 static grid_u8 rubble_type_grid;
 static grid_u8 highlight_grid;
 
-int map_building_at(int grid_offset)
-{
-    return map_grid_is_valid_offset(grid_offset) ? buildings_grid.items[grid_offset] : 0;
-}
-
 int map_building_from_buffer(buffer *buildings, int grid_offset)
 {
     buffer_set(buildings, grid_offset * sizeof(uint16_t));
@@ -22,7 +17,7 @@ int map_building_from_buffer(buffer *buildings, int grid_offset)
 
 void map_building_set(int grid_offset, int building_id)
 {
-    buildings_grid.items[grid_offset] = building_id;
+    map_buildings_grid.items[grid_offset] = building_id;
 }
 
 void map_building_damage_clear(int grid_offset)
@@ -67,7 +62,7 @@ void map_set_rubble_building_type(int grid_offset, building_type type)
 
 void map_building_clear(void)
 {
-    map_grid_clear_u16(buildings_grid.items);
+    map_grid_clear_u16(map_buildings_grid.items);
     map_grid_clear_u8(damage_grid.items);
     map_grid_clear_u8(rubble_type_grid.items);
 }
@@ -79,13 +74,13 @@ void map_clear_highlights(void)
 
 void map_building_save_state(buffer *buildings, buffer *damage)
 {
-    map_grid_save_state_u16(buildings_grid.items, buildings);
+    map_grid_save_state_u16(map_buildings_grid.items, buildings);
     map_grid_save_state_u8(damage_grid.items, damage);
 }
 
 void map_building_load_state(buffer *buildings, buffer *damage)
 {
-    map_grid_load_state_u16(buildings_grid.items, buildings);
+    map_grid_load_state_u16(map_buildings_grid.items, buildings);
     map_grid_load_state_u8(damage_grid.items, damage);
 }
 
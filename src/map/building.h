@@ -3,13 +3,22 @@
 
 #include "building/type.h"
 #include "core/buffer.h"
+#include "map/grid.h"
+
+/**
+ * Building IDs of all tiles, exposed for map_building_at()
+ */
+extern grid_u16 map_buildings_grid;
 
 /**
  * Returns the building at the given offset
  * @param grid_offset Map offset
  * @return Building ID of building at offset, 0 means no building
  */
-int map_building_at(int grid_offset);
+static inline int map_building_at(int grid_offset)
+{
+    return map_grid_is_valid_offset(grid_offset) ? map_buildings_grid.items[grid_offset] : 0;
+}
 
 int map_building_from_buffer(buffer *buildings, int grid_offset);
 
@@ -6,6 +6,8 @@
 
 #define OFFSET(x,y) (x + GRID_SIZE * y)
 
+#define CONVERSION_CHUNK_SIZE 1024
+
 struct map_data_t map_data;
 
 static const int DIRECTION_DELTA[] = {
@@ -51,31 +53,6 @@ void map_grid_init(int width, int height, int start_offset, int border_size)
     map_data.border_size = border_size;
 }
 
-int map_grid_is_valid_offset(int grid_offset)
-{
-    return grid_offset >= 0 && grid_offset < GRID_SIZE * GRID_SIZE;
-}
-
-int map_grid_offset(int x, int y)
-{
-    return map_data.start_offset + x + y * GRID_SIZE;
-}
-
-int map_grid_offset_to_x(int grid_offset)
-{
-    return (grid_offset - map_data.start_offset) % GRID_SIZE;
-}
-
-int map_grid_offset_to_y(int grid_offset)
-{
-    return (grid_offset - map_data.start_offset) / GRID_SIZE;
-}
-
-int map_grid_delta(int x, int y)
-{
-    return y * GRID_SIZE + x;
-}
-
 int map_grid_add_delta(int grid_offset, int x, int y)
 {
     int raw_x = grid_offset % GRID_SIZE;
@@ -243,6 +220,12 @@ void map_grid_copy_u32(const uint32_t *src, uint32_t *dst)
     memcpy(dst, src, GRID_SIZE * GRID_SIZE * sizeof(uint32_t));
 }
 
+static int chunk_size(int offset)
+{
+    int remaining = GRID_SIZE * GRID_SIZE - offset;
+    return remaining < CONVERSION_CHUNK_SIZE ? remaining : CONVERSION_CHUNK_SIZE;
+}
+
 void map_grid_save_state_u8(const uint8_t *grid, buffer *buf)
 {
     buffer_write_raw(buf, grid, GRID_SIZE * GRID_SIZE);
@@ -255,23 +238,24 @@ void map_grid_save_state_i8(const int8_t *grid, buffer *buf)
 
 void map_grid_save_state_u16(const uint16_t *grid, buffer *buf)
 {
-    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
-        buffer_write_u16(buf, grid[i]);
-    }
+    buffer_write_u16_array(buf, grid, GRID_SIZE * GRID_SIZE);
 }
 
 void map_grid_save_state_u32_to_u16(const uint32_t *grid, buffer *buf)
 {
-    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
-        buffer_write_u16(buf, (uint16_t) grid[i]);
+    uint16_t values[CONVERSION_CHUNK_SIZE];
+    for (int offset = 0; offset < GRID_SIZE * GRID_SIZE; offset += CONVERSION_CHUNK_SIZE) {
+        int count = chunk_size(offset);
+        for (int i = 0; i < count; i++) {
+            values[i] = (uint16_t) grid[offset + i];
+        }
+        buffer_write_u16_array(buf, values, count);
     }
 }
 
 void map_grid_save_state_u32(const uint32_t *grid, buffer *buf)
 {
-    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
-        buffer_write_u32(buf, grid[i]);
-    }
+    buffer_write_u32_array(buf, grid, GRID_SIZE * GRID_SIZE);
 }
 
 void map_grid_load_state_u8(uint8_t *grid, buffer *buf)
@@ -286,21 +270,22 @@ void map_grid_load_state_i8(int8_t *grid, buffer *buf)
 
 void map_grid_load_state_u16(uint16_t *grid, buffer *buf)
 {
-    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
-        grid[i] = buffer_read_u16(buf);
-    }
+    buffer_read_u16_array(buf, grid, GRID_SIZE * GRID_SIZE);
 }
 
 void map_grid_load_state_u16_to_u32(uint32_t *grid, buffer *buf)
 {
-    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
-        grid[i] = buffer_read_u16(buf);
+    uint16_t values[CONVERSION_CHUNK_SIZE];
+    for (int offset = 0; offset < GRID_SIZE * GRID_SIZE; offset += CONVERSION_CHUNK_SIZE) {
+        int count = chunk_size(offset);
+        buffer_read_u16_array(buf, values, count);
+        for (int i = 0; i < count; i++) {
+            grid[offset + i] = values[i];
+        }
     }
 }
 
 void map_grid_load_state_u32(uint32_t *grid, buffer *buf)
 {
-    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
-        grid[i] = buffer_read_u32(buf);
-    }
+    buffer_read_u32_array(buf, grid, GRID_SIZE * GRID_SIZE);
 }
@@ -2,6 +2,7 @@
 #define MAP_GRID_H
 
 #include "core/buffer.h"
+#include "map/data.h"
 
 #include <stdint.h>
 
@@ -31,15 +32,30 @@ typedef struct {
 
 void map_grid_init(int width, int height, int start_offset, int border_size);
 
-int map_grid_is_valid_offset(int grid_offset);
-
-int map_grid_offset(int x, int y);
-
-int map_grid_offset_to_x(int grid_offset);
-
-int map_grid_offset_to_y(int grid_offset);
-
-int map_grid_delta(int x, int y);
+static inline int map_grid_is_valid_offset(int grid_offset)
+{
+    return grid_offset >= 0 && grid_offset < GRID_SIZE * GRID_SIZE;
+}
+
+static inline int map_grid_offset(int x, int y)
+{
+    return map_data.start_offset + x + y * GRID_SIZE;
+}
+
+static inline int map_grid_offset_to_x(int grid_offset)
+{
+    return (grid_offset - map_data.start_offset) % GRID_SIZE;
+}
+
+static inline int map_grid_offset_to_y(int grid_offset)
+{
+    return (grid_offset - map_data.start_offset) / GRID_SIZE;
+}
+
+static inline int map_grid_delta(int x, int y)
+{
+    return y * GRID_SIZE + x;
+}
 
 /**
  * Adds the specified X and Y to the given offset with error checking
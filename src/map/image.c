@@ -6,11 +6,11 @@
 #include "core/image_group.h"
 #include "map/building_tiles.h"
 #include "map/grid.h"
+#include "map/journal.h"
 #include "map/orientation.h"
 #include "map/tiles.h"
 
 static grid_u32 images;
-static grid_u32 images_backup;
 
 unsigned int map_image_at(int grid_offset)
 {
@@ -19,24 +19,10 @@ unsigned int map_image_at(int grid_offset)
 
 void map_image_set(int grid_offset, int image_id)
 {
+    map_journal_record(grid_offset);
     images.items[grid_offset] = image_id;
 }
 
-void map_image_backup(void)
-{
-    map_grid_copy_u32(images.items, images_backup.items);
-}
-
-void map_image_restore(void)
-{
-    map_grid_copy_u32(images_backup.items, images.items);
-}
-
-void map_image_restore_at(int grid_offset)
-{
-    images.items[grid_offset] = images_backup.items[grid_offset];
-}
-
 void map_image_clear(void)
 {
     map_grid_clear_u32(images.items);
@@ -9,6 +9,8 @@
 #include "map/terrain.h"
 
 #define MAX_TILES 8
+#define NUM_PATTERNS (1 << MAX_TILES)
+#define NO_CONTEXT 0xff
 
 struct terrain_image_context {
     const unsigned char tiles[MAX_TILES];
@@ -291,6 +293,12 @@ static struct {
     {terrain_images_aqueduct, 16}
 };
 
+// context index per group for each combination of matching neighbours, one bit per neighbour
+static struct {
+    uint8_t context_index[CONTEXT_MAX_ITEMS][NUM_PATTERNS];
+    int initialized;
+} lookup;
+
 static void clear_current_offset(struct terrain_image_context *items, int num_items)
 {
     for (int i = 0; i < num_items; i++) {
@@ -325,25 +333,57 @@ static int context_matches_tiles(const struct terrain_image_context *context, co
     return 1;
 }
 
-static const terrain_image *get_image(int group, int tiles[MAX_TILES])
+static int find_context(int group, const int tiles[MAX_TILES])
 {
-    static terrain_image result;
-
-    result.is_valid = 0;
-    struct terrain_image_context *context = context_pointers[group].context;
+    const struct terrain_image_context *context = context_pointers[group].context;
     int size = context_pointers[group].size;
     for (int i = 0; i < size; i++) {
         if (context_matches_tiles(&context[i], tiles)) {
-            context[i].current_item_offset++;
-            if (context[i].current_item_offset >= context[i].max_item_offset) {
-                context[i].current_item_offset = 0;
+            return i;
+        }
+    }
+    return NO_CONTEXT;
+}
+
+static void init_lookup(void)
+{
+    // every combination of neighbours is matched once against the context list, in list order,
+    // so that the first matching context wins like it does in a linear search
+    for (int group = 0; group < CONTEXT_MAX_ITEMS; group++) {
+        for (int pattern = 0; pattern < NUM_PATTERNS; pattern++) {
+            int tiles[MAX_TILES];
+            for (int i = 0; i < MAX_TILES; i++) {
+                tiles[i] = (pattern >> i) & 1;
             }
-            result.is_valid = 1;
-            result.group_offset = context[i].offset_for_orientation[city_view_orientation() / 2];
-            result.item_offset = context[i].current_item_offset;
-            result.aqueduct_offset = context[i].aqueduct_offset;
-            break;
+            lookup.context_index[group][pattern] = find_context(group, tiles);
+        }
+    }
+    lookup.initialized = 1;
+}
+
+static const terrain_image *get_image(int group, int tiles[MAX_TILES])
+{
+    static terrain_image result;
+
+    if (!lookup.initialized) {
+        init_lookup();
+    }
+    int pattern = 0;
+    for (int i = 0; i < MAX_TILES; i++) {
+        pattern |= (tiles[i] & 1) << i;
+    }
+    result.is_valid = 0;
+    int index = lookup.context_index[group][pattern];
+    if (index != NO_CONTEXT) {
+        struct terrain_image_context *context = &context_pointers[group].context[index];
+        context->current_item_offset++;
+        if (context->current_item_offset >= context->max_item_offset) {
+            context->current_item_offset = 0;
         }
+        result.is_valid = 1;
+        result.group_offset = context->offset_for_orientation[city_view_orientation() / 2];
+        result.item_offset = context->current_item_offset;
+        result.aqueduct_offset = context->aqueduct_offset;
     }
     return &result;
 }
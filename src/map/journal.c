@@ -0,0 +1,122 @@
+#include "journal.h"
+
+#include "map/aqueduct.h"
+#include "map/building.h"
+#include "map/grid.h"
+#include "map/image.h"
+#include "map/property.h"
+#include "map/sprite.h"
+#include "map/terrain.h"
+
+typedef struct {
+    int grid_offset;
+    uint32_t terrain;
+    uint32_t image;
+    uint8_t aqueduct;
+    uint8_t bitfields;
+    uint8_t edge;
+    uint8_t sprite;
+} journal_entry;
+
+static struct {
+    int recording;
+    int num_entries;
+    grid_u8 logged;
+    journal_entry entries[GRID_SIZE * GRID_SIZE];
+} data;
+
+void map_journal_start(void)
+{
+    map_journal_clear();
+    data.recording = 1;
+}
+
+void map_journal_clear(void)
+{
+    for (int i = 0; i < data.num_entries; i++) {
+        data.logged.items[data.entries[i].grid_offset] = 0;
+    }
+    data.num_entries = 0;
+    data.recording = 0;
+}
+
+int map_journal_is_recording(void)
+{
+    return data.recording;
+}
+
+void map_journal_record(int grid_offset)
+{
+    if (!data.recording || data.logged.items[grid_offset]) {
+        return;
+    }
+    data.logged.items[grid_offset] = 1;
+    journal_entry *entry = &data.entries[data.num_entries++];
+    entry->grid_offset = grid_offset;
+    entry->terrain = map_terrain_get(grid_offset);
+    entry->image = map_image_at(grid_offset);
+    entry->aqueduct = map_aqueduct_at(grid_offset);
+    entry->sprite = map_sprite_animation_at(grid_offset);
+    map_property_get_tile(grid_offset, &entry->bitfields, &entry->edge);
+}
+
+void map_journal_restore(int layers)
+{
+    for (int i = 0; i < data.num_entries; i++) {
+        const journal_entry *entry = &data.entries[i];
+        int grid_offset = entry->grid_offset;
+        if (layers & MAP_JOURNAL_TERRAIN) {
+            map_terrain_set(grid_offset, entry->terrain);
+        }
+        if (layers & MAP_JOURNAL_AQUEDUCT) {
+            map_aqueduct_set(grid_offset, entry->aqueduct);
+        }
+        if (layers & MAP_JOURNAL_PROPERTY) {
+            map_property_set_tile(grid_offset, entry->bitfields, entry->edge);
+        }
+        if ((layers & MAP_JOURNAL_IMAGE) ||
+            ((layers & MAP_JOURNAL_IMAGE_WITHOUT_BUILDING) && !map_building_at(grid_offset))) {
+            map_image_set(grid_offset, entry->image);
+        }
+        if (layers & MAP_JOURNAL_SPRITE) {
+            map_sprite_animation_set(grid_offset, entry->sprite);
+        }
+    }
+}
+
+void map_journal_backup(int layers)
+{
+    for (int i = 0; i < data.num_entries; i++) {
+        journal_entry *entry = &data.entries[i];
+        int grid_offset = entry->grid_offset;
+        if (layers & MAP_JOURNAL_TERRAIN) {
+            entry->terrain = map_terrain_get(grid_offset);
+        }
+        if (layers & MAP_JOURNAL_AQUEDUCT) {
+            entry->aqueduct = map_aqueduct_at(grid_offset);
+        }
+        if (layers & MAP_JOURNAL_PROPERTY) {
+            map_property_get_tile(grid_offset, &entry->bitfields, &entry->edge);
+        }
+        if (layers & MAP_JOURNAL_IMAGE) {
+            entry->image = map_image_at(grid_offset);
+        }
+        if (layers & MAP_JOURNAL_SPRITE) {
+            entry->sprite = map_sprite_animation_at(grid_offset);
+        }
+    }
+}
+
+void map_journal_fill_aqueduct_backup(uint8_t *grid)
+{
+    for (int i = 0; i < data.num_entries; i++) {
+        grid[data.entries[i].grid_offset] = data.entries[i].aqueduct;
+    }
+}
+
+void map_journal_fill_sprite_backup(uint8_t *grid)
+{
+    for (int i = 0; i < data.num_entries; i++) {
+        grid[data.entries[i].grid_offset] = data.entries[i].sprite;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef MAP_JOURNAL_H
+#define MAP_JOURNAL_H
+
+#include <stdint.h>
+
+/**
+ * @file
+ * Change log of map tiles, used to undo construction.
+ * While recording, the first write to a tile stores the original contents of all undoable grids
+ * for that tile. Restoring only touches the logged tiles instead of copying complete grids.
+ */
+
+typedef enum {
+    MAP_JOURNAL_TERRAIN = 1,
+    MAP_JOURNAL_AQUEDUCT = 2,
+    MAP_JOURNAL_PROPERTY = 4,
+    MAP_JOURNAL_IMAGE = 8,
+    MAP_JOURNAL_IMAGE_WITHOUT_BUILDING = 16, // only restores images of tiles that have no building
+    MAP_JOURNAL_SPRITE = 32,
+    MAP_JOURNAL_ALL = MAP_JOURNAL_TERRAIN | MAP_JOURNAL_AQUEDUCT | MAP_JOURNAL_PROPERTY |
+        MAP_JOURNAL_IMAGE | MAP_JOURNAL_SPRITE
+} map_journal_layer;
+
+/**
+ * Empties the log and starts recording: the current map becomes the state to restore to
+ */
+void map_journal_start(void);
+
+/**
+ * Empties the log and stops recording
+ */
+void map_journal_clear(void);
+
+int map_journal_is_recording(void);
+
+/**
+ * Logs the tile if it has not been changed since recording started.
+ * Must be called before any of the undoable grids is changed for the tile.
+ * @param grid_offset Tile about to be changed
+ */
+void map_journal_record(int grid_offset);
+
+/**
+ * Restores the given layers of all logged tiles to their state when recording started
+ * @param layers Combination of map_journal_layer flags
+ */
+void map_journal_restore(int layers);
+
+/**
+ * Makes the current contents of the given layers the state to restore to, keeping other layers logged
+ * @param layers Combination of map_journal_layer flags
+ */
+void map_journal_backup(int layers);
+
+/**
+ * Writes the original values of the logged tiles into a copy of the aqueduct grid
+ * @param grid Aqueduct grid, filled with the current values
+ */
+void map_journal_fill_aqueduct_backup(uint8_t *grid);
+
+/**
+ * Writes the original values of the logged tiles into a copy of the sprite grid
+ * @param grid Sprite grid, filled with the current values
+ */
+void map_journal_fill_sprite_backup(uint8_t *grid);
+
+#endif // MAP_JOURNAL_H
@@ -1,6 +1,7 @@
 #include "property.h"
 
 #include "map/grid.h"
+#include "map/journal.h"
 #include "map/random.h"
 
 enum {
@@ -32,9 +33,6 @@ enum {
 static grid_u8 edge_grid;
 static grid_u8 bitfields_grid;
 
-static grid_u8 edge_backup;
-static grid_u8 bitfields_backup;
-
 static int edge_for(int x, int y)
 {
     return 8 * y + x;
@@ -53,11 +51,13 @@ int map_property_is_draw_tile_from_buffer(buffer *edge, int grid_offset)
 
 void map_property_mark_draw_tile(int grid_offset)
 {
+    map_journal_record(grid_offset);
     edge_grid.items[grid_offset] |= EDGE_LEFTMOST_TILE;
 }
 
 void map_property_clear_draw_tile(int grid_offset)
 {
+    map_journal_record(grid_offset);
     edge_grid.items[grid_offset] &= ~EDGE_LEFTMOST_TILE;
 }
 
@@ -68,11 +68,21 @@ int map_property_is_native_land(int grid_offset)
 
 void map_property_mark_native_land(int grid_offset)
 {
+    map_journal_record(grid_offset);
     edge_grid.items[grid_offset] |= EDGE_NATIVE_LAND;
 }
 
 void map_property_clear_all_native_land(void)
 {
+    if (map_journal_is_recording()) {
+        for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+            if (edge_grid.items[i] & EDGE_NATIVE_LAND) {
+                map_journal_record(i);
+                edge_grid.items[i] &= EDGE_NO_NATIVE_LAND;
+            }
+        }
+        return;
+    }
     map_grid_and_u8(edge_grid.items, EDGE_NO_NATIVE_LAND);
 }
 
@@ -98,6 +108,7 @@ int map_property_is_multi_tile_xy(int grid_offset, int x, int y)
 
 void map_property_set_multi_tile_xy(int grid_offset, int x, int y, int is_draw_tile)
 {
+    map_journal_record(grid_offset);
     if (is_draw_tile) {
         edge_grid.items[grid_offset] = edge_for(x, y) | EDGE_LEFTMOST_TILE;
     } else {
@@ -107,6 +118,7 @@ void map_property_set_multi_tile_xy(int grid_offset, int x, int y, int is_draw_t
 
 void map_property_clear_multi_tile_xy(int grid_offset)
 {
+    map_journal_record(grid_offset);
     // only keep native land marker
     edge_grid.items[grid_offset] &= EDGE_NATIVE_LAND;
 }
@@ -138,6 +150,7 @@ int map_property_multi_tile_size_from_buffer(buffer *bitfields, int grid_offset)
 
 void map_property_set_multi_tile_size(int grid_offset, int size)
 {
+    map_journal_record(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_SIZES;
     switch (size) {
         case 2: bitfields_grid.items[grid_offset] |= BIT_SIZE2; break;
@@ -175,11 +188,13 @@ int map_property_is_plaza_or_earthquake(int grid_offset)
 
 void map_property_mark_plaza_or_earthquake(int grid_offset)
 {
+    map_journal_record(grid_offset);
     bitfields_grid.items[grid_offset] |= BIT_PLAZA_OR_EARTHQUAKE;
 }
 
 void map_property_clear_plaza_or_earthquake(int grid_offset)
 {
+    map_journal_record(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_PLAZA;
 }
 
@@ -190,11 +205,13 @@ int map_property_is_constructing(int grid_offset)
 
 void map_property_mark_constructing(int grid_offset)
 {
+    map_journal_record(grid_offset);
     bitfields_grid.items[grid_offset] |= BIT_CONSTRUCTION;
 }
 
 void map_property_clear_constructing(int grid_offset)
 {
+    map_journal_record(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_CONSTRUCTION;
 }
 
@@ -205,16 +222,27 @@ int map_property_is_deleted(int grid_offset)
 
 void map_property_mark_deleted(int grid_offset)
 {
+    map_journal_record(grid_offset);
     bitfields_grid.items[grid_offset] |= BIT_DELETED;
 }
 
 void map_property_clear_deleted(int grid_offset)
 {
+    map_journal_record(grid_offset);
     bitfields_grid.items[grid_offset] &= BIT_NO_DELETED;
 }
 
 void map_property_clear_constructing_and_deleted(void)
 {
+    if (map_journal_is_recording()) {
+        for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+            if (bitfields_grid.items[i] & (BIT_CONSTRUCTION | BIT_DELETED)) {
+                map_journal_record(i);
+                bitfields_grid.items[i] &= BIT_NO_CONSTRUCTION_AND_DELETED;
+            }
+        }
+        return;
+    }
     map_grid_and_u8(bitfields_grid.items, BIT_NO_CONSTRUCTION_AND_DELETED);
 }
 
@@ -224,16 +252,17 @@ void map_property_clear(void)
     map_grid_clear_u8(edge_grid.items);
 }
 
-void map_property_backup(void)
+void map_property_get_tile(int grid_offset, uint8_t *bitfields, uint8_t *edge)
 {
-    map_grid_copy_u8(bitfields_grid.items, bitfields_backup.items);
-    map_grid_copy_u8(edge_grid.items, edge_backup.items);
+    *bitfields = bitfields_grid.items[grid_offset];
+    *edge = edge_grid.items[grid_offset];
 }
 
-void map_property_restore(void)
+void map_property_set_tile(int grid_offset, uint8_t bitfields, uint8_t edge)
 {
-    map_grid_copy_u8(bitfields_backup.items, bitfields_grid.items);
-    map_grid_copy_u8(edge_backup.items, edge_grid.items);
+    map_journal_record(grid_offset);
+    bitfields_grid.items[grid_offset] = bitfields;
+    edge_grid.items[grid_offset] = edge;
 }
 
 void map_property_save_state(buffer *bitfields, buffer *edge)
@@ -3,6 +3,8 @@
 
 #include "core/buffer.h"
 
+#include <stdint.h>
+
 enum {
     EDGE_X0Y0 = 0,
     EDGE_X1Y0 = 1,
@@ -55,8 +57,8 @@ void map_property_clear_constructing_and_deleted(void);
 
 void map_property_clear(void);
 
-void map_property_backup(void);
-void map_property_restore(void);
+void map_property_get_tile(int grid_offset, uint8_t *bitfields, uint8_t *edge);
+void map_property_set_tile(int grid_offset, uint8_t bitfields, uint8_t edge);
 
 void map_property_save_state(buffer *bitfields, buffer *edge);
 void map_property_load_state(buffer *bitfields, buffer *edge);
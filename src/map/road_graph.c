@@ -0,0 +1,122 @@
+#include "road_graph.h"
+
+#include "building/building.h"
+#include "building/roadblock.h"
+#include "map/building.h"
+#include "map/data.h"
+#include "map/grid.h"
+#include "map/road_access.h"
+#include "map/routing_terrain.h"
+#include "map/terrain.h"
+
+#define NODE_STRAIGHT_DIRECTIONS 0x55
+#define NODE_STRETCH_SHIFT 8
+#define NODE_STRETCH 0xf00
+#define NODE_CACHED 0x1000
+#define NODE_SEGMENT 0x2000
+
+// Roadblocks make the neighbourhood depend on the walker, and granaries look one tile further
+#define ROADBLOCK_RADIUS 2
+
+static grid_u16 nodes;
+static grid_u8 roadblock_nearby;
+
+static void mark_roadblocks(void)
+{
+    map_grid_clear_u8(roadblock_nearby.items);
+    int grid_offset = map_data.start_offset;
+    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
+        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+            int building_id = map_building_at(grid_offset);
+            if (!building_id || !building_type_is_roadblock(building_get(building_id)->type)) {
+                continue;
+            }
+            int x_min, y_min, x_max, y_max;
+            map_grid_get_area(x, y, 1, ROADBLOCK_RADIUS, &x_min, &y_min, &x_max, &y_max);
+            for (int yy = y_min; yy <= y_max; yy++) {
+                for (int xx = x_min; xx <= x_max; xx++) {
+                    roadblock_nearby.items[map_grid_offset(xx, yy)] = 1;
+                }
+            }
+        }
+    }
+}
+
+static uint16_t build_node(int grid_offset)
+{
+    int road_tiles[8];
+    // no roadblock nearby, so the permission does not matter
+    int adjacent = map_get_adjacent_road_tiles_for_roaming(grid_offset, road_tiles, PERMISSION_NONE);
+    int stretch = map_get_diagonal_road_tiles_for_roaming(grid_offset, road_tiles);
+    uint16_t node = NODE_CACHED | (stretch << NODE_STRETCH_SHIFT);
+    for (int i = 0; i < 8; i++) {
+        if (road_tiles[i]) {
+            node |= 1 << i;
+        }
+    }
+    if (adjacent == 2) {
+        node |= NODE_SEGMENT;
+    }
+    return node;
+}
+
+void map_road_graph_update(void)
+{
+    map_grid_clear_u16(nodes.items);
+    mark_roadblocks();
+    int grid_offset = map_data.start_offset;
+    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
+        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+            if (roadblock_nearby.items[grid_offset]) {
+                continue;
+            }
+            if (map_routing_citizen_is_road(grid_offset) ||
+                map_terrain_is(grid_offset, TERRAIN_ROAD | TERRAIN_ACCESS_RAMP)) {
+                nodes.items[grid_offset] = build_node(grid_offset);
+            }
+        }
+    }
+}
+
+int map_road_graph_segment_exit(int grid_offset, int came_from_direction)
+{
+    uint16_t node = nodes.items[grid_offset];
+    if (!(node & NODE_SEGMENT) || came_from_direction < 0 || (came_from_direction & 1) ||
+        !(node & (1 << came_from_direction))) {
+        return -1;
+    }
+    int even_directions = node & NODE_STRAIGHT_DIRECTIONS & ~(1 << came_from_direction);
+    for (int dir = 0; dir < 8; dir += 2) {
+        if (even_directions & (1 << dir)) {
+            return dir;
+        }
+    }
+    return -1;
+}
+
+int map_road_graph_adjacent_road_tiles(int grid_offset, int *road_tiles, int permission)
+{
+    uint16_t node = nodes.items[grid_offset];
+    if (!(node & NODE_CACHED)) {
+        return map_get_adjacent_road_tiles_for_roaming(grid_offset, road_tiles, permission);
+    }
+    int adjacent = 0;
+    for (int i = 0; i < 8; i += 2) {
+        road_tiles[i] = (node >> i) & 1;
+        road_tiles[i + 1] = 0;
+        adjacent += road_tiles[i];
+    }
+    return adjacent;
+}
+
+int map_road_graph_diagonal_road_tiles(int grid_offset, int *road_tiles)
+{
+    uint16_t node = nodes.items[grid_offset];
+    if (!(node & NODE_CACHED)) {
+        return map_get_diagonal_road_tiles_for_roaming(grid_offset, road_tiles);
+    }
+    for (int i = 1; i < 8; i += 2) {
+        road_tiles[i] = (node >> i) & 1;
+    }
+    return (node & NODE_STRETCH) >> NODE_STRETCH_SHIFT;
+}
@@ -0,0 +1,30 @@
+#ifndef MAP_ROAD_GRAPH_H
+#define MAP_ROAD_GRAPH_H
+
+/**
+ * Rebuilds the roaming road graph from the current citizen routing terrain.
+ * Every road tile is classified as a segment tile (exactly two road neighbours) or a junction,
+ * and its neighbourhood as seen by roaming walkers is cached.
+ */
+void map_road_graph_update(void);
+
+/**
+ * Gets the direction in which a roaming walker leaves a segment tile, without any neighbour checks
+ * @param grid_offset The tile the walker is on
+ * @param came_from_direction The direction of the road tile the walker came from
+ * @return The other road direction of the segment, or -1 if the tile is a junction, is not cached
+ *         or the walker did not come from the segment itself
+ */
+int map_road_graph_segment_exit(int grid_offset, int came_from_direction);
+
+/**
+ * Cached version of map_get_adjacent_road_tiles_for_roaming
+ */
+int map_road_graph_adjacent_road_tiles(int grid_offset, int *road_tiles, int permission);
+
+/**
+ * Cached version of map_get_diagonal_road_tiles_for_roaming
+ */
+int map_road_graph_diagonal_road_tiles(int grid_offset, int *road_tiles);
+
+#endif // MAP_ROAD_GRAPH_H
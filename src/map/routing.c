@@ -10,6 +10,7 @@
 #include "map/terrain.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #define MAX_QUEUE GRID_SIZE * GRID_SIZE
 #define GUARD 50000
@@ -33,6 +34,13 @@ static struct {
     int dst_y;
 } distance;
 
+static struct {
+    grid_i16 determined;
+    routed_building_type type;
+    int source_offset;
+    int is_valid;
+} building_distances;
+
 static struct {
     int total_routes_calculated;
     int enemy_routes_calculated;
@@ -384,14 +392,36 @@ static int map_can_place_initial_road_or_aqueduct(int grid_offset, int is_aquedu
     }
 }
 
+static int restore_building_distances(routed_building_type type, int source_offset)
+{
+    if (!building_distances.is_valid ||
+        building_distances.type != type || building_distances.source_offset != source_offset) {
+        return 0;
+    }
+    memcpy(distance.determined.items, building_distances.determined.items, sizeof(distance.determined.items));
+    return 1;
+}
+
+static void store_building_distances(routed_building_type type, int source_offset)
+{
+    memcpy(building_distances.determined.items, distance.determined.items, sizeof(distance.determined.items));
+    building_distances.type = type;
+    building_distances.source_offset = source_offset;
+    building_distances.is_valid = 1;
+}
+
 int map_routing_calculate_distances_for_building(routed_building_type type, int x, int y)
 {
+    int source_offset = map_grid_offset(x, y);
+    if (restore_building_distances(type, source_offset)) {
+        return 1;
+    }
     if (type == ROUTED_BUILDING_WALL) {
-        route_queue_all_from(map_grid_offset(x, y), DIRECTIONS_NO_DIAGONALS, callback_calc_distance_build_wall, 0);
+        route_queue_all_from(source_offset, DIRECTIONS_NO_DIAGONALS, callback_calc_distance_build_wall, 0);
+        store_building_distances(type, source_offset);
         return 1;
     }
     clear_data();
-    int source_offset = map_grid_offset(x, y);
     if (!map_can_place_initial_road_or_aqueduct(source_offset, type != ROUTED_BUILDING_ROAD)) {
         return 0;
     }
@@ -405,9 +435,15 @@ int map_routing_calculate_distances_for_building(routed_building_type type, int
     } else {
         route_queue_all_from(source_offset, DIRECTIONS_NO_DIAGONALS, callback_calc_distance_build_aqueduct, 0);
     }
+    store_building_distances(type, source_offset);
     return 1;
 }
 
+void map_routing_clear_building_distances(void)
+{
+    building_distances.is_valid = 0;
+}
+
 static int callback_delete_wall_aqueduct(int next_offset, int dist)
 {
     if (terrain_land_citizen.items[next_offset] < CITIZEN_0_ROAD) {
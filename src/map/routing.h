@@ -14,8 +14,16 @@ void map_routing_calculate_distances(int x, int y);
 void map_routing_calculate_distances_water_boat(int x, int y);
 void map_routing_calculate_distances_water_flotsam(int x, int y);
 
+/**
+ * Calculates the distances for placing a routed building from the given start tile.
+ * The result is kept for subsequent calls with the same type and start tile, so dragging
+ * only floods the map once. The kept distances are discarded by map_routing_clear_building_distances.
+ * @return 1 if the building can be started on the tile, 0 otherwise
+ */
 int map_routing_calculate_distances_for_building(routed_building_type type, int x, int y);
 
+void map_routing_clear_building_distances(void);
+
 void map_routing_delete_first_wall_or_aqueduct(int x, int y);
 
 int map_routing_distance(int grid_offset);
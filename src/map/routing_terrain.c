@@ -9,6 +9,8 @@
 #include "map/image.h"
 #include "map/property.h"
 #include "map/random.h"
+#include "map/road_graph.h"
+#include "map/routing.h"
 #include "map/routing_data.h"
 #include "map/sprite.h"
 #include "map/terrain.h"
@@ -142,6 +144,8 @@ void map_routing_update_land_citizen(void)
             }
         }
     }
+    map_road_graph_update();
+    map_routing_clear_building_distances();
 }
 
 static int get_land_type_noncitizen(int grid_offset)
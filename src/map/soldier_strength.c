@@ -5,11 +5,70 @@
 #include "map/grid.h"
 #include "map/routing.h"
 
+#include <string.h>
+
+typedef struct {
+    int x_min;
+    int y_min;
+    int x_max;
+    int y_max;
+} area;
+
 static grid_u8 strength;
 
+// influence added since the last apply, as corner deltas of the areas, resolved with a prefix sum
+static struct {
+    int16_t amount[GRID_SIZE + 1][GRID_SIZE + 1];
+    int16_t coverage[GRID_SIZE + 1][GRID_SIZE + 1];
+    area pending;
+    area influenced;
+} data;
+
+static void clear_area(area *a)
+{
+    a->x_min = GRID_SIZE;
+    a->y_min = GRID_SIZE;
+    a->x_max = -1;
+    a->y_max = -1;
+}
+
+static void extend_area(area *a, int x_min, int y_min, int x_max, int y_max)
+{
+    if (x_min < a->x_min) {
+        a->x_min = x_min;
+    }
+    if (y_min < a->y_min) {
+        a->y_min = y_min;
+    }
+    if (x_max > a->x_max) {
+        a->x_max = x_max;
+    }
+    if (y_max > a->y_max) {
+        a->y_max = y_max;
+    }
+}
+
+static void clear_pending(void)
+{
+    for (int y = data.pending.y_min; y <= data.pending.y_max + 1; y++) {
+        int size = (data.pending.x_max - data.pending.x_min + 2) * sizeof(int16_t);
+        memset(&data.amount[y][data.pending.x_min], 0, size);
+        memset(&data.coverage[y][data.pending.x_min], 0, size);
+    }
+    clear_area(&data.pending);
+}
+
 void map_soldier_strength_clear(void)
 {
     map_grid_clear_u8(strength.items);
+    clear_pending();
+    clear_area(&data.influenced);
+}
+
+static void add_corner(int x, int y, int amount, int coverage)
+{
+    data.amount[y][x] += amount;
+    data.coverage[y][x] += coverage;
 }
 
 void map_soldier_strength_add(int x, int y, int radius, int amount)
@@ -17,17 +76,47 @@ void map_soldier_strength_add(int x, int y, int radius, int amount)
     int x_min, y_min, x_max, y_max;
     map_grid_get_area(x, y, 1, radius, &x_min, &y_min, &x_max, &y_max);
 
-    for (int yy = y_min; yy <= y_max; yy++) {
-        for (int xx = x_min; xx <= x_max; xx++) {
-            int grid_offset = map_grid_offset(xx, yy);
-            strength.items[grid_offset] += amount;
-            if (map_has_figure_at(grid_offset)) {
-                if (figure_is_legion(figure_get(map_figure_at(grid_offset)))) {
-                    strength.items[grid_offset] += 2;
-                }
+    add_corner(x_min, y_min, amount, 1);
+    add_corner(x_max + 1, y_min, -amount, -1);
+    add_corner(x_min, y_max + 1, -amount, -1);
+    add_corner(x_max + 1, y_max + 1, amount, 1);
+    extend_area(&data.pending, x_min, y_min, x_max, y_max);
+}
+
+void map_soldier_strength_apply(void)
+{
+    const area *a = &data.pending;
+    if (a->x_min > a->x_max) {
+        return;
+    }
+    int column_amount[GRID_SIZE];
+    int column_coverage[GRID_SIZE];
+    memset(column_amount, 0, sizeof(column_amount));
+    memset(column_coverage, 0, sizeof(column_coverage));
+
+    for (int y = a->y_min; y <= a->y_max; y++) {
+        int row_amount = 0;
+        int row_coverage = 0;
+        for (int x = a->x_min; x <= a->x_max; x++) {
+            row_amount += data.amount[y][x];
+            row_coverage += data.coverage[y][x];
+            column_amount[x] += row_amount;
+            column_coverage[x] += row_coverage;
+            int coverage = column_coverage[x];
+            if (!coverage) {
+                continue;
             }
+            int grid_offset = map_grid_offset(x, y);
+            int value = column_amount[x];
+            // a legion soldier on the tile counts once more for every area that covers it
+            if (map_has_figure_at(grid_offset) && figure_is_legion(figure_get(map_figure_at(grid_offset)))) {
+                value += 2 * coverage;
+            }
+            strength.items[grid_offset] += value;
         }
     }
+    extend_area(&data.influenced, a->x_min, a->y_min, a->x_max, a->y_max);
+    clear_pending();
 }
 
 int map_soldier_strength_get(int grid_offset)
@@ -40,12 +129,26 @@ int map_soldier_strength_get_max(int x, int y, int radius, int *out_x, int *out_
     int x_min, y_min, x_max, y_max;
     map_grid_get_area(x, y, 1, radius, &x_min, &y_min, &x_max, &y_max);
 
+    // there is no strength outside the influenced area
+    if (x_min < data.influenced.x_min) {
+        x_min = data.influenced.x_min;
+    }
+    if (y_min < data.influenced.y_min) {
+        y_min = data.influenced.y_min;
+    }
+    if (x_max > data.influenced.x_max) {
+        x_max = data.influenced.x_max;
+    }
+    if (y_max > data.influenced.y_max) {
+        y_max = data.influenced.y_max;
+    }
+
     int max_value = 0;
     int max_tile_x = 0, max_tile_y = 0;
     for (int yy = y_min; yy <= y_max; yy++) {
         for (int xx = x_min; xx <= x_max; xx++) {
             int grid_offset = map_grid_offset(xx, yy);
-            if (map_routing_distance(grid_offset) > 0 && strength.items[grid_offset] > max_value) {
+            if (strength.items[grid_offset] > max_value && map_routing_distance(grid_offset) > 0) {
                 max_value = strength.items[grid_offset];
                 max_tile_x = xx;
                 max_tile_y = yy;
@@ -5,6 +5,12 @@ void map_soldier_strength_clear(void);
 
 void map_soldier_strength_add(int x, int y, int radius, int amount);
 
+/**
+ * Adds the influence of all map_soldier_strength_add calls since the last apply to the map.
+ * The strength of the added areas is only visible after calling this.
+ */
+void map_soldier_strength_apply(void);
+
 int map_soldier_strength_get(int grid_offset);
 
 int map_soldier_strength_get_max(int x, int y, int radius, int *out_x, int *out_y);
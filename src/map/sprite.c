@@ -1,8 +1,10 @@
 #include "sprite.h"
 
 #include "map/grid.h"
+#include "map/journal.h"
 
 static grid_u8 sprite;
+// only used to keep the backup of the savegame, undo uses map/journal.c
 static grid_u8 sprite_backup;
 
 int map_sprite_animation_at(int grid_offset)
@@ -12,6 +14,7 @@ int map_sprite_animation_at(int grid_offset)
 
 void map_sprite_animation_set(int grid_offset, int value)
 {
+    map_journal_record(grid_offset);
     sprite.items[grid_offset] = value;
 }
 
@@ -22,11 +25,13 @@ int map_sprite_bridge_at(int grid_offset)
 
 void map_sprite_bridge_set(int grid_offset, int value)
 {
+    map_journal_record(grid_offset);
     sprite.items[grid_offset] = value;
 }
 
 void map_sprite_clear_tile(int grid_offset)
 {
+    map_journal_record(grid_offset);
     sprite.items[grid_offset] = 0;
 }
 
@@ -35,19 +40,13 @@ void map_sprite_clear(void)
     map_grid_clear_u8(sprite.items);
 }
 
-void map_sprite_backup(void)
-{
-    map_grid_copy_u8(sprite.items, sprite_backup.items);
-}
-
-void map_sprite_restore(void)
-{
-    map_grid_copy_u8(sprite_backup.items, sprite.items);
-}
-
 void map_sprite_save_state(buffer *buf, buffer *backup)
 {
     map_grid_save_state_u8(sprite.items, buf);
+    if (map_journal_is_recording()) {
+        map_grid_copy_u8(sprite.items, sprite_backup.items);
+        map_journal_fill_sprite_backup(sprite_backup.items);
+    }
     map_grid_save_state_u8(sprite_backup.items, backup);
 }
 
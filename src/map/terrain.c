@@ -3,25 +3,159 @@
 #include "city/map.h"
 #include "core/image.h"
 #include "map/grid.h"
+#include "map/journal.h"
 #include "map/ring.h"
 #include "map/routing.h"
 
-static grid_u32 terrain_grid;
-static grid_u32 terrain_grid_backup;
+#include <string.h>
 
-int map_terrain_is(int grid_offset, int terrain)
+#define PLANE_COUNT 17
+#define PLANE_TERRAIN ((1 << PLANE_COUNT) - 1)
+#define WORDS_PER_ROW ((GRID_SIZE + 63) / 64)
+#define PLANE_MIN_AREA_TILES 16
+
+typedef uint64_t plane_row[WORDS_PER_ROW];
+
+typedef struct {
+    int row_min;
+    int row_max;
+    int col_min;
+    int word_min;
+    int word_max;
+    uint64_t first_mask;
+    uint64_t last_mask;
+    int plane_count;
+    plane_row *planes[PLANE_COUNT];
+} plane_query;
+
+grid_u32 map_terrain_grid;
+
+// One bit per tile for each terrain flag, derived from the terrain grid
+static plane_row planes[PLANE_COUNT][GRID_SIZE];
+
+static void update_planes(int grid_offset, uint32_t old_terrain, uint32_t new_terrain)
 {
-    return map_grid_is_valid_offset(grid_offset) && terrain_grid.items[grid_offset] & terrain;
+    uint32_t changed = (old_terrain ^ new_terrain) & PLANE_TERRAIN;
+    if (!changed) {
+        return;
+    }
+    int row = grid_offset / GRID_SIZE;
+    int word = (grid_offset % GRID_SIZE) >> 6;
+    uint64_t bit = (uint64_t) 1 << (grid_offset % GRID_SIZE & 63);
+    for (int plane = 0; changed; plane++, changed >>= 1) {
+        if (changed & 1) {
+            planes[plane][row][word] ^= bit;
+        }
+    }
 }
 
-int map_terrain_is_superset(int grid_offset, int terrain_sum)
+static void rebuild_planes(void)
+{
+    memset(planes, 0, sizeof(planes));
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        update_planes(i, 0, map_terrain_grid.items[i]);
+    }
+}
+
+static void clear_planes(int terrain)
+{
+    terrain &= PLANE_TERRAIN;
+    for (int plane = 0; terrain; plane++, terrain >>= 1) {
+        if (terrain & 1) {
+            memset(planes[plane], 0, sizeof(planes[plane]));
+        }
+    }
+}
+
+static void select_planes(plane_query *query, int terrain)
+{
+    query->plane_count = 0;
+    terrain &= PLANE_TERRAIN;
+    for (int plane = 0; terrain; plane++, terrain >>= 1) {
+        if (terrain & 1) {
+            query->planes[query->plane_count++] = planes[plane];
+        }
+    }
+}
+
+static int init_query(plane_query *query, int x_min, int y_min, int x_max, int y_max, int terrain)
+{
+    if (x_min > x_max || y_min > y_max) {
+        return 0;
+    }
+    int grid_offset = map_grid_offset(x_min, y_min);
+    int col_max = grid_offset % GRID_SIZE + x_max - x_min;
+    query->row_min = grid_offset / GRID_SIZE;
+    query->row_max = query->row_min + y_max - y_min;
+    query->col_min = grid_offset % GRID_SIZE;
+    query->word_min = query->col_min >> 6;
+    query->word_max = col_max >> 6;
+    query->first_mask = ~(uint64_t) 0 << (query->col_min & 63);
+    query->last_mask = ~(uint64_t) 0 >> (63 - (col_max & 63));
+    select_planes(query, terrain);
+    return 1;
+}
+
+static uint64_t query_mask(const plane_query *query, int word)
+{
+    uint64_t mask = ~(uint64_t) 0;
+    if (word == query->word_min) {
+        mask &= query->first_mask;
+    }
+    if (word == query->word_max) {
+        mask &= query->last_mask;
+    }
+    return mask;
+}
+
+static uint64_t tiles_with_any(const plane_query *query, int row, int word)
+{
+    uint64_t tiles = 0;
+    for (int i = 0; i < query->plane_count; i++) {
+        tiles |= query->planes[i][row][word];
+    }
+    return tiles;
+}
+
+static uint64_t tiles_with_all(const plane_query *query, int row, int word)
+{
+    uint64_t tiles = ~(uint64_t) 0;
+    for (int i = 0; i < query->plane_count; i++) {
+        tiles &= query->planes[i][row][word];
+    }
+    return tiles;
+}
+
+static int area_has_any(int x_min, int y_min, int x_max, int y_max, int terrain)
 {
-    return map_grid_is_valid_offset(grid_offset) && ((terrain_grid.items[grid_offset] & terrain_sum) == terrain_sum);
+    // checking the tiles one by one is quicker for small areas
+    if ((x_max - x_min + 1) * (y_max - y_min + 1) <= PLANE_MIN_AREA_TILES || (terrain & ~PLANE_TERRAIN)) {
+        for (int yy = y_min; yy <= y_max; yy++) {
+            for (int xx = x_min; xx <= x_max; xx++) {
+                if (map_terrain_grid.items[map_grid_offset(xx, yy)] & terrain) {
+                    return 1;
+                }
+            }
+        }
+        return 0;
+    }
+    plane_query query;
+    if (!init_query(&query, x_min, y_min, x_max, y_max, terrain)) {
+        return 0;
+    }
+    for (int row = query.row_min; row <= query.row_max; row++) {
+        for (int word = query.word_min; word <= query.word_max; word++) {
+            if (tiles_with_any(&query, row, word) & query_mask(&query, word)) {
+                return 1;
+            }
+        }
+    }
+    return 0;
 }
 
-int map_terrain_get(int grid_offset)
+int map_terrain_is_superset(int grid_offset, int terrain_sum)
 {
-    return terrain_grid.items[grid_offset];
+    return map_grid_is_valid_offset(grid_offset) && ((map_terrain_grid.items[grid_offset] & terrain_sum) == terrain_sum);
 }
 
 int map_terrain_get_from_buffer_16(buffer *buf, int grid_offset)
@@ -38,46 +172,118 @@ int map_terrain_get_from_buffer_32(buffer *buf, int grid_offset)
 
 void map_terrain_set(int grid_offset, int terrain)
 {
-    terrain_grid.items[grid_offset] = terrain;
+    map_journal_record(grid_offset);
+    update_planes(grid_offset, map_terrain_grid.items[grid_offset], terrain);
+    map_terrain_grid.items[grid_offset] = terrain;
 }
 
 void map_terrain_add(int grid_offset, int terrain)
 {
-    terrain_grid.items[grid_offset] |= terrain;
+    map_journal_record(grid_offset);
+    uint32_t old_terrain = map_terrain_grid.items[grid_offset];
+    map_terrain_grid.items[grid_offset] |= terrain;
+    update_planes(grid_offset, old_terrain, map_terrain_grid.items[grid_offset]);
 }
 
 void map_terrain_remove(int grid_offset, int terrain)
 {
-    terrain_grid.items[grid_offset] &= ~terrain;
+    map_journal_record(grid_offset);
+    uint32_t old_terrain = map_terrain_grid.items[grid_offset];
+    map_terrain_grid.items[grid_offset] &= ~terrain;
+    update_planes(grid_offset, old_terrain, map_terrain_grid.items[grid_offset]);
 }
 
-void map_terrain_add_with_radius(int x, int y, int size, int radius, int terrain)
+static void change_tiles(const plane_query *query, int row, int word, uint64_t tiles, int terrain, int add)
 {
-    int x_min, y_min, x_max, y_max;
-    map_grid_get_area(x, y, size, radius, &x_min, &y_min, &x_max, &y_max);
-
-    for (int yy = y_min; yy <= y_max; yy++) {
-        for (int xx = x_min; xx <= x_max; xx++) {
-            map_terrain_add(map_grid_offset(xx, yy), terrain);
+    for (int i = 0; i < query->plane_count; i++) {
+        if (add) {
+            query->planes[i][row][word] |= tiles;
+        } else {
+            query->planes[i][row][word] &= ~tiles;
         }
     }
+    int grid_offset = row * GRID_SIZE + word * 64;
+    while (tiles) {
+        if (!(tiles & 0xff)) {
+            tiles >>= 8;
+            grid_offset += 8;
+            continue;
+        }
+        if (tiles & 1) {
+            map_journal_record(grid_offset);
+            if (add) {
+                map_terrain_grid.items[grid_offset] |= terrain;
+            } else {
+                map_terrain_grid.items[grid_offset] &= ~terrain;
+            }
+        }
+        tiles >>= 1;
+        grid_offset++;
+    }
 }
 
-void map_terrain_remove_with_radius(int x, int y, int size, int radius, int terrain)
+static void change_with_radius(int x, int y, int size, int radius, int terrain, int add)
 {
     int x_min, y_min, x_max, y_max;
     map_grid_get_area(x, y, size, radius, &x_min, &y_min, &x_max, &y_max);
 
-    for (int yy = y_min; yy <= y_max; yy++) {
-        for (int xx = x_min; xx <= x_max; xx++) {
-            map_terrain_remove(map_grid_offset(xx, yy), terrain);
+    if (terrain & ~PLANE_TERRAIN) {
+        for (int yy = y_min; yy <= y_max; yy++) {
+            for (int xx = x_min; xx <= x_max; xx++) {
+                if (add) {
+                    map_terrain_add(map_grid_offset(xx, yy), terrain);
+                } else {
+                    map_terrain_remove(map_grid_offset(xx, yy), terrain);
+                }
+            }
         }
+        return;
     }
+    plane_query query;
+    if (!init_query(&query, x_min, y_min, x_max, y_max, terrain)) {
+        return;
+    }
+    // only the tiles that change are touched
+    for (int row = query.row_min; row <= query.row_max; row++) {
+        for (int word = query.word_min; word <= query.word_max; word++) {
+            uint64_t tiles = add ? ~tiles_with_all(&query, row, word) : tiles_with_any(&query, row, word);
+            change_tiles(&query, row, word, tiles & query_mask(&query, word), terrain, add);
+        }
+    }
+}
+
+void map_terrain_add_with_radius(int x, int y, int size, int radius, int terrain)
+{
+    change_with_radius(x, y, size, radius, terrain, 1);
+}
+
+void map_terrain_remove_with_radius(int x, int y, int size, int radius, int terrain)
+{
+    change_with_radius(x, y, size, radius, terrain, 0);
 }
 
 void map_terrain_remove_all(int terrain)
 {
-    map_grid_and_u32(terrain_grid.items, ~terrain);
+    if (!map_journal_is_recording()) {
+        map_grid_and_u32(map_terrain_grid.items, ~terrain);
+        clear_planes(terrain);
+        return;
+    }
+    if (terrain & ~PLANE_TERRAIN) {
+        for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+            if (map_terrain_grid.items[i] & terrain) {
+                map_terrain_remove(i, terrain);
+            }
+        }
+        return;
+    }
+    plane_query query;
+    select_planes(&query, terrain);
+    for (int row = 0; row < GRID_SIZE; row++) {
+        for (int word = 0; word < WORDS_PER_ROW; word++) {
+            change_tiles(&query, row, word, tiles_with_any(&query, row, word), terrain, 0);
+        }
+    }
 }
 
 int map_terrain_count_directly_adjacent_with_type(int grid_offset, int terrain)
@@ -155,29 +361,16 @@ int map_terrain_has_adjacent_y_with_type(int grid_offset, int terrain)
 
 int map_terrain_exists_tile_in_area_with_type(int x, int y, int size, int terrain)
 {
-    for (int yy = y; yy < y + size; yy++) {
-        for (int xx = x; xx < x + size; xx++) {
-            if (map_grid_is_inside(xx, yy, 1) && terrain_grid.items[map_grid_offset(xx, yy)] & terrain) {
-                return 1;
-            }
-        }
-    }
-    return 0;
+    int x_min = x, y_min = y, x_max = x + size - 1, y_max = y + size - 1;
+    map_grid_bound_area(&x_min, &y_min, &x_max, &y_max);
+    return area_has_any(x_min, y_min, x_max, y_max, terrain);
 }
 
 int map_terrain_exists_tile_in_radius_with_type(int x, int y, int size, int radius, int terrain)
 {
     int x_min, y_min, x_max, y_max;
     map_grid_get_area(x, y, size, radius, &x_min, &y_min, &x_max, &y_max);
-
-    for (int yy = y_min; yy <= y_max; yy++) {
-        for (int xx = x_min; xx <= x_max; xx++) {
-            if (map_terrain_is(map_grid_offset(xx, yy), terrain)) {
-                return 1;
-            }
-        }
-    }
-    return 0;
+    return area_has_any(x_min, y_min, x_max, y_max, terrain);
 }
 
 int map_terrain_exists_rock_in_radius(int x, int y, int size, int radius)
@@ -208,7 +401,7 @@ int map_terrain_exists_clear_tile_in_radius(int x, int y, int size, int radius,
     for (int yy = y_min; yy <= y_max; yy++) {
         for (int xx = x_min; xx <= x_max; xx++) {
             int grid_offset = map_grid_offset(xx, yy);
-            if (grid_offset != except_grid_offset && !(terrain_grid.items[grid_offset] & TERRAIN_NOT_CLEAR)) {
+            if (grid_offset != except_grid_offset && !(map_terrain_grid.items[grid_offset] & TERRAIN_NOT_CLEAR)) {
                 *x_tile = xx;
                 *y_tile = yy;
                 return 1;
@@ -381,19 +574,10 @@ void map_terrain_add_triumphal_arch_roads(int x, int y, int orientation)
     }
 }
 
-void map_terrain_backup(void)
-{
-    map_grid_copy_u32(terrain_grid.items, terrain_grid_backup.items);
-}
-
-void map_terrain_restore(void)
-{
-    map_grid_copy_u32(terrain_grid_backup.items, terrain_grid.items);
-}
-
 void map_terrain_clear(void)
 {
-    map_grid_clear_u32(terrain_grid.items);
+    map_grid_clear_u32(map_terrain_grid.items);
+    memset(planes, 0, sizeof(planes));
 }
 
 void map_terrain_init_outside_map(void)
@@ -406,29 +590,30 @@ void map_terrain_init_outside_map(void)
         int y_outside_map = y < y_start || y >= y_start + map_height;
         for (int x = 0; x < GRID_SIZE; x++) {
             if (y_outside_map || x < x_start || x >= x_start + map_width) {
-                terrain_grid.items[x + GRID_SIZE * y] = TERRAIN_MAP_EDGE;
+                map_terrain_grid.items[x + GRID_SIZE * y] = TERRAIN_MAP_EDGE;
             }
         }
     }
+    rebuild_planes();
 }
 
 void map_terrain_save_state(buffer *buf)
 {
-    map_grid_save_state_u32(terrain_grid.items, buf);
+    map_grid_save_state_u32(map_terrain_grid.items, buf);
 }
 
 void map_terrain_save_state_legacy(buffer *buf)
 {
-    map_grid_save_state_u32_to_u16(terrain_grid.items, buf);
+    map_grid_save_state_u32_to_u16(map_terrain_grid.items, buf);
 }
 
 static void determine_original_trees(buffer *images, int legacy_buffer)
 {
     for (int y = 0; y < GRID_SIZE; y++) {
         for (int x = 0; x < GRID_SIZE; x++) {
-            if (terrain_grid.items[x + GRID_SIZE * y] & TERRAIN_TREE &&
-                !(terrain_grid.items[x + GRID_SIZE * y] & TERRAIN_WATER)) {
-                terrain_grid.items[x + GRID_SIZE * y] |= TERRAIN_ORIGINALLY_TREE;
+            if (map_terrain_grid.items[x + GRID_SIZE * y] & TERRAIN_TREE &&
+                !(map_terrain_grid.items[x + GRID_SIZE * y] & TERRAIN_WATER)) {
+                map_terrain_grid.items[x + GRID_SIZE * y] |= TERRAIN_ORIGINALLY_TREE;
                 if (images) {
                     buffer_set(images, (x + GRID_SIZE * y) * (legacy_buffer ? 2 : 4));
                     int image_id = legacy_buffer ? buffer_read_u16(images) : buffer_read_u32(images);
@@ -461,9 +646,10 @@ static void determine_original_trees(buffer *images, int legacy_buffer)
 void map_terrain_load_state(buffer *buf, int expanded_terrain_data, buffer *images, int legacy_image_buffer)
 {
     if (expanded_terrain_data) {
-        map_grid_load_state_u32(terrain_grid.items, buf);
+        map_grid_load_state_u32(map_terrain_grid.items, buf);
     } else {
-        map_grid_load_state_u16_to_u32(terrain_grid.items, buf);
+        map_grid_load_state_u16_to_u32(map_terrain_grid.items, buf);
     }
     determine_original_trees(images, legacy_image_buffer);
+    rebuild_planes();
 }
@@ -2,6 +2,7 @@
 #define MAP_TERRAIN_H
 
 #include "core/buffer.h"
+#include "map/grid.h"
 
 enum {
     TERRAIN_TREE = 1,
@@ -34,11 +35,22 @@ enum {
     TERRAIN_MAP_EDGE = TERRAIN_TREE | TERRAIN_WATER
 };
 
-int map_terrain_is(int grid_offset, int terrain);
+/**
+ * Terrain flags of all tiles, exposed for the inline accessors. Change it through the map_terrain functions
+ */
+extern grid_u32 map_terrain_grid;
+
+static inline int map_terrain_is(int grid_offset, int terrain)
+{
+    return map_grid_is_valid_offset(grid_offset) && map_terrain_grid.items[grid_offset] & terrain;
+}
 
 int map_terrain_is_superset(int grid_offset, int terrain_sum);
 
-int map_terrain_get(int grid_offset);
+static inline int map_terrain_get(int grid_offset)
+{
+    return map_terrain_grid.items[grid_offset];
+}
 
 int map_terrain_get_from_buffer_16(buffer *buf, int grid_offset);
 
@@ -105,10 +117,6 @@ void map_terrain_add_roadblock_road(int x, int y);
 void map_terrain_add_gatehouse_roads(int x, int y, int orientation);
 void map_terrain_add_triumphal_arch_roads(int x, int y, int orientation);
 
-void map_terrain_backup(void);
-
-void map_terrain_restore(void);
-
 void map_terrain_clear(void);
 
 void map_terrain_init_outside_map(void);
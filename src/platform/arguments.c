@@ -4,6 +4,8 @@
 
 #define CURSOR_SCALE_ERROR_MESSAGE "Option --cursor-scale must be followed by a scale value of 1, 1.5 or 2"
 #define DISPLAY_SCALE_ERROR_MESSAGE "Option --display-scale must be followed by a scale value between 0.5 and 5"
+#define RECORD_ERROR_MESSAGE "Option --record must be followed by a file name"
+#define RENDER_CITY_ERROR_MESSAGE "Option --render-city must be followed by a saved game and an image file name"
 #define UNKNOWN_OPTION_ERROR_MESSAGE "Option %s not recognized"
 
 static int parse_decimal_as_percentage(const char *str)
@@ -54,6 +56,9 @@ int platform_parse_arguments(int argc, char **argv, augustus_args *output_args)
     output_args->cursor_scale_percentage = 0;
     output_args->force_windowed = 0;
     output_args->launch_asset_previewer = 0;
+    output_args->record_file = 0;
+    output_args->render_city_saved_game = 0;
+    output_args->render_city_output_file = 0;
 
     for (int i = 1; i < argc; i++) {
         // we ignore "-psn" arguments, this is needed to launch the app
@@ -94,6 +99,24 @@ int platform_parse_arguments(int argc, char **argv, augustus_args *output_args)
             output_args->force_windowed = 1;
         } else if (SDL_strcmp(argv[i], "--asset-previewer") == 0) {
             output_args->launch_asset_previewer = 1;
+        } else if (SDL_strcmp(argv[i], "--record") == 0) {
+            if (i + 1 < argc) {
+                output_args->record_file = argv[i + 1];
+                i++;
+            } else {
+                SDL_Log(RECORD_ERROR_MESSAGE);
+                ok = 0;
+            }
+        } else if (SDL_strcmp(argv[i], "--render-city") == 0) {
+            if (i + 2 < argc) {
+                output_args->render_city_saved_game = argv[i + 1];
+                output_args->render_city_output_file = argv[i + 2];
+                output_args->force_windowed = 1;
+                i += 2;
+            } else {
+                SDL_Log(RENDER_CITY_ERROR_MESSAGE);
+                ok = 0;
+            }
         } else if (SDL_strcmp(argv[i], "--help") == 0) {
             ok = 0;
         } else if (SDL_strncmp(argv[i], "--", 2) == 0) {
@@ -113,6 +136,11 @@ int platform_parse_arguments(int argc, char **argv, augustus_args *output_args)
         SDL_Log("          Scales the mouse cursor by a factor of NUMBER. Number can be 1, 1.5 or 2");
         SDL_Log("--windowed");
         SDL_Log("          Forces the game to start in windowed mode");
+        SDL_Log("--record FILE");
+        SDL_Log("          Records the player commands of the first game played to FILE, for replaying");
+        SDL_Log("--render-city SAVED_GAME IMAGE");
+        SDL_Log("          Saves a PNG picture of the whole city in SAVED_GAME to IMAGE and exits.");
+        SDL_Log("          Set SDL_VIDEODRIVER=offscreen to run it without a display");
         SDL_Log("The last argument, if present, is interpreted as data directory for the Caesar 3 installation");
     }
     return ok;
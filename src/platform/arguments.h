@@ -7,6 +7,9 @@ typedef struct {
     int cursor_scale_percentage;
     int force_windowed;
     int launch_asset_previewer;
+    const char *record_file;
+    const char *render_city_saved_game;
+    const char *render_city_output_file;
 } augustus_args;
 
 int platform_parse_arguments(int argc, char **argv, augustus_args *output_args);
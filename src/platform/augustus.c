@@ -6,10 +6,13 @@
 #include "core/lang.h"
 #include "core/log.h"
 #include "core/time.h"
+#include "game/file.h"
 #include "game/game.h"
+#include "game/replay.h"
 #include "game/settings.h"
 #include "game/system.h"
 #include "graphics/screen.h"
+#include "graphics/screenshot.h"
 #include "graphics/window.h"
 #include "input/mouse.h"
 #include "input/touch.h"
@@ -23,6 +26,7 @@
 #include "platform/screen.h"
 #include "platform/touch.h"
 #include "window/asset_previewer.h"
+#include "window/city.h"
 
 #include "tinyfiledialogs/tinyfiledialogs.h"
 
@@ -115,6 +119,48 @@ void system_exit(void)
     post_event(USER_EVENT_QUIT);
 }
 
+time_millis system_get_millis(void)
+{
+    return SDL_GetTicks();
+}
+
+system_thread *system_thread_run(int (*function)(void *), void *data)
+{
+    return (system_thread *) SDL_CreateThread(function, "augustus", data);
+}
+
+int system_thread_wait(system_thread *thread)
+{
+    int status = 0;
+    SDL_WaitThread((SDL_Thread *) thread, &status);
+    return status;
+}
+
+system_semaphore *system_semaphore_create(int value)
+{
+    return (system_semaphore *) SDL_CreateSemaphore(value);
+}
+
+void system_semaphore_destroy(system_semaphore *semaphore)
+{
+    SDL_DestroySemaphore((SDL_sem *) semaphore);
+}
+
+void system_semaphore_wait(system_semaphore *semaphore)
+{
+    SDL_SemWait((SDL_sem *) semaphore);
+}
+
+int system_semaphore_try_wait(system_semaphore *semaphore)
+{
+    return SDL_SemTryWait((SDL_sem *) semaphore) == 0;
+}
+
+void system_semaphore_post(system_semaphore *semaphore)
+{
+    SDL_SemPost((SDL_sem *) semaphore);
+}
+
 void system_resize(int width, int height)
 {
     static int s_width;
@@ -602,7 +648,8 @@ static void setup(const augustus_args *args)
     system_init_cursors(config_get(CONFIG_SCREEN_CURSOR_SCALE));
 
     time_set_millis(SDL_GetTicks());
-    
+    game_replay_set_record_file(args->record_file);
+
     int result = args->launch_asset_previewer ? window_asset_previewer_show() : game_init();
 
     if (!result) {
@@ -614,6 +661,20 @@ static void setup(const augustus_args *args)
     data.active = 1;
 }
 
+static int render_city(const char *saved_game, const char *output_file)
+{
+    if (game_file_load_saved_game(saved_game) != 1) {
+        SDL_Log("Unable to load saved game %s", saved_game);
+        return 0;
+    }
+    window_city_show();
+    if (!graphics_save_full_city_screenshot(output_file)) {
+        SDL_Log("Unable to save the city to %s", output_file);
+        return 0;
+    }
+    return 1;
+}
+
 int main(int argc, char **argv)
 {
     augustus_args args;
@@ -621,6 +682,11 @@ int main(int argc, char **argv)
 
     setup(&args);
 
+    if (args.render_city_saved_game) {
+        // the settings are not saved, so forcing windowed mode does not stick
+        exit_with_status(render_city(args.render_city_saved_game, args.render_city_output_file) ? 0 : 1);
+    }
+
     mouse_set_inside_window(1);
     run_and_draw();
 
@@ -554,3 +554,13 @@ int platform_file_manager_create_directory(const char *name)
 #endif
 }
 
+int platform_file_manager_get_file_stamp(FILE *stream, int *size, int64_t *modified)
+{
+    struct stat file_info;
+    if (fstat(fileno(stream), &file_info) != 0) {
+        return 0;
+    }
+    *size = (int) file_info.st_size;
+    *modified = (int64_t) file_info.st_mtime;
+    return 1;
+}
@@ -1,6 +1,7 @@
 #ifndef PLATFORM_FILE_MANAGER_H
 #define PLATFORM_FILE_MANAGER_H
 
+#include <stdint.h>
 #include <stdio.h>
 
 enum {
@@ -82,6 +83,14 @@ FILE *platform_file_manager_open_asset(const char *asset, const char *mode);
  */
 int platform_file_manager_close_file(FILE *stream);
 
+/**
+ * Gets the size and last modification time of an opened file
+ * @param stream The file
+ * @param size Out: size of the file in bytes
+ * @param modified Out: last modification time of the file
+ * @return 1 if the information could be retrieved, 0 otherwise
+ */
+int platform_file_manager_get_file_stamp(FILE *stream, int *size, int64_t *modified);
 
 /**
  * Removes a file
@@ -24,6 +24,10 @@
 
 #define MAX_CHANNELS 160
 
+// every channel holds at most one chunk, so there is always room for a new one
+#define MAX_CACHED_CHUNKS (MAX_CHANNELS + 32)
+#define MAX_CACHED_BYTES (32 * 1024 * 1024)
+
 #if SDL_VERSION_ATLEAST(2, 0, 7)
 #define USE_SDL_AUDIOSTREAM
 #endif
@@ -37,9 +41,17 @@ static struct {
 } vita_music_data;
 #endif
 
+typedef struct {
+    char filename[FILE_NAME_MAX];
+    Mix_Chunk *chunk;
+    int users;
+    unsigned int last_used;
+} cached_chunk;
+
 typedef struct {
     const char *filename;
     Mix_Chunk *chunk;
+    cached_chunk *cached;
 } sound_channel;
 
 static struct {
@@ -48,6 +60,25 @@ static struct {
     sound_channel channels[MAX_CHANNELS];
 } data;
 
+// decoded chunks by file name, the least recently used unused chunk is freed first
+static struct {
+    cached_chunk items[MAX_CACHED_CHUNKS];
+    int total_bytes;
+    unsigned int use_counter;
+    SDL_mutex *lock;
+    SDL_Thread *preload_thread;
+    SDL_atomic_t stop_preload;
+    int first_preload_channel;
+    int last_preload_channel;
+    struct {
+        int hits;
+        int misses;
+        int loads;
+        Uint32 total_load_millis;
+        Uint32 max_load_millis;
+    } stats;
+} cache;
+
 static struct {
     SDL_AudioFormat format;
     SDL_AudioFormat dst_format;
@@ -73,7 +104,9 @@ static void init_channels(void)
     data.initialized = 1;
     for (int i = 0; i < MAX_CHANNELS; i++) {
         data.channels[i].chunk = 0;
+        data.channels[i].cached = 0;
     }
+    cache.lock = SDL_CreateMutex();
 }
 
 void sound_device_open(void)
@@ -110,12 +143,49 @@ void sound_device_open(void)
     }
 }
 
+static void wait_for_preload(void)
+{
+    if (cache.preload_thread) {
+        SDL_AtomicSet(&cache.stop_preload, 1);
+        SDL_WaitThread(cache.preload_thread, 0);
+        cache.preload_thread = 0;
+    }
+}
+
+static void free_cache(void)
+{
+    for (int i = 0; i < MAX_CACHED_CHUNKS; i++) {
+        if (cache.items[i].chunk) {
+            Mix_FreeChunk(cache.items[i].chunk);
+            cache.items[i].chunk = 0;
+        }
+    }
+    cache.total_bytes = 0;
+    if (cache.lock) {
+        SDL_DestroyMutex(cache.lock);
+        cache.lock = 0;
+    }
+}
+
+static void log_cache_stats(void)
+{
+    log_info("Sound cache hits:", 0, cache.stats.hits);
+    log_info("Sound cache misses:", 0, cache.stats.misses);
+    if (cache.stats.loads) {
+        log_info("Average sound load time in ms:", 0, cache.stats.total_load_millis / cache.stats.loads);
+        log_info("Slowest sound load time in ms:", 0, cache.stats.max_load_millis);
+    }
+}
+
 void sound_device_close(void)
 {
     if (data.initialized) {
         for (int i = 0; i < MAX_CHANNELS; i++) {
             sound_device_stop_channel(i);
         }
+        wait_for_preload();
+        log_cache_stats();
+        free_cache();
         Mix_CloseAudio();
         data.initialized = 0;
     }
@@ -139,14 +209,189 @@ static Mix_Chunk *load_chunk(const char *filename)
     }
 }
 
+static cached_chunk *find_cached_chunk(const char *filename)
+{
+    for (int i = 0; i < MAX_CACHED_CHUNKS; i++) {
+        if (cache.items[i].chunk && strcmp(cache.items[i].filename, filename) == 0) {
+            return &cache.items[i];
+        }
+    }
+    return 0;
+}
+
+static void free_cached_chunk(cached_chunk *item)
+{
+    cache.total_bytes -= item->chunk->alen;
+    Mix_FreeChunk(item->chunk);
+    item->chunk = 0;
+}
+
+static cached_chunk *find_free_slot(int bytes, int evict)
+{
+    while (1) {
+        cached_chunk *free_slot = 0;
+        cached_chunk *least_recent = 0;
+        for (int i = 0; i < MAX_CACHED_CHUNKS; i++) {
+            cached_chunk *item = &cache.items[i];
+            if (!item->chunk) {
+                free_slot = item;
+            } else if (!item->users && (!least_recent || item->last_used < least_recent->last_used)) {
+                least_recent = item;
+            }
+        }
+        if (free_slot && cache.total_bytes + bytes <= MAX_CACHED_BYTES) {
+            return free_slot;
+        }
+        if (!evict || !least_recent) {
+            // chunks in use are never freed, so the cache may go over its size when all of them are
+            return evict ? free_slot : 0;
+        }
+        free_cached_chunk(least_recent);
+    }
+}
+
+static cached_chunk *add_cached_chunk(const char *filename, Mix_Chunk *chunk, int evict)
+{
+    cached_chunk *item = find_free_slot(chunk->alen, evict);
+    if (!item) {
+        return 0;
+    }
+    strncpy(item->filename, filename, FILE_NAME_MAX - 1);
+    item->filename[FILE_NAME_MAX - 1] = 0;
+    item->chunk = chunk;
+    item->users = 0;
+    item->last_used = ++cache.use_counter;
+    cache.total_bytes += chunk->alen;
+    return item;
+}
+
+static Mix_Chunk *load_chunk_timed(const char *filename, Uint32 *millis)
+{
+    Uint32 start = SDL_GetTicks();
+    Mix_Chunk *chunk = load_chunk(filename);
+    *millis = SDL_GetTicks() - start;
+    return chunk;
+}
+
+static void record_load_time(Uint32 millis)
+{
+    cache.stats.loads++;
+    cache.stats.total_load_millis += millis;
+    if (millis > cache.stats.max_load_millis) {
+        cache.stats.max_load_millis = millis;
+    }
+}
+
+static cached_chunk *acquire_chunk(const char *filename)
+{
+    if (!filename || !filename[0]) {
+        return 0;
+    }
+    SDL_LockMutex(cache.lock);
+    cached_chunk *item = find_cached_chunk(filename);
+    if (item) {
+        cache.stats.hits++;
+    } else {
+        // the file is decoded without holding the lock so that the preload thread can go on
+        SDL_UnlockMutex(cache.lock);
+        Uint32 millis;
+        Mix_Chunk *chunk = load_chunk_timed(filename, &millis);
+        SDL_LockMutex(cache.lock);
+        cache.stats.misses++;
+        record_load_time(millis);
+        if (!chunk) {
+            SDL_UnlockMutex(cache.lock);
+            return 0;
+        }
+        item = find_cached_chunk(filename);
+        if (item) {
+            // the preload thread was faster
+            Mix_FreeChunk(chunk);
+        } else {
+            item = add_cached_chunk(filename, chunk, 1);
+        }
+        if (!item) {
+            SDL_UnlockMutex(cache.lock);
+            Mix_FreeChunk(chunk);
+            return 0;
+        }
+    }
+    item->users++;
+    item->last_used = ++cache.use_counter;
+    SDL_UnlockMutex(cache.lock);
+    return item;
+}
+
+static void release_chunk(cached_chunk *item)
+{
+    SDL_LockMutex(cache.lock);
+    item->users--;
+    SDL_UnlockMutex(cache.lock);
+}
+
+static void set_channel_chunk(sound_channel *channel, cached_chunk *item)
+{
+    channel->cached = item;
+    channel->chunk = item ? item->chunk : 0;
+}
+
 static int load_channel(sound_channel *channel)
 {
     if (!channel->chunk && channel->filename) {
-        channel->chunk = load_chunk(channel->filename);
+        set_channel_chunk(channel, acquire_chunk(channel->filename));
     }
     return channel->chunk ? 1 : 0;
 }
 
+static int preload_channels(void *unused)
+{
+    for (int i = cache.first_preload_channel; i <= cache.last_preload_channel; i++) {
+        const char *filename = data.channels[i].filename;
+        if (SDL_AtomicGet(&cache.stop_preload)) {
+            break;
+        }
+        SDL_LockMutex(cache.lock);
+        int is_cached = !filename || find_cached_chunk(filename);
+        SDL_UnlockMutex(cache.lock);
+        if (is_cached) {
+            continue;
+        }
+        Uint32 millis;
+        Mix_Chunk *chunk = load_chunk_timed(filename, &millis);
+        if (!chunk) {
+            continue;
+        }
+        SDL_LockMutex(cache.lock);
+        record_load_time(millis);
+        // preloading only fills the free space of the cache
+        int added = !find_cached_chunk(filename) && add_cached_chunk(filename, chunk, 0);
+        SDL_UnlockMutex(cache.lock);
+        if (!added) {
+            Mix_FreeChunk(chunk);
+        }
+    }
+    return 0;
+}
+
+void sound_device_preload_channels(int first_channel, int last_channel)
+{
+    if (!data.initialized || !cache.lock || !config_get(CONFIG_GENERAL_ENABLE_AUDIO)) {
+        return;
+    }
+    // a preload that is still running belongs to the previous city, it is stopped before preloading again
+    wait_for_preload();
+    if (last_channel >= MAX_CHANNELS) {
+        last_channel = MAX_CHANNELS - 1;
+    }
+    cache.first_preload_channel = first_channel;
+    cache.last_preload_channel = last_channel;
+    SDL_AtomicSet(&cache.stop_preload, 0);
+    cache.preload_thread = SDL_CreateThread(preload_channels, "sound preload", 0);
+    if (!cache.preload_thread) {
+        log_error("Unable to preload the city sounds", SDL_GetError(), 0);
+    }
+}
+
 void sound_device_init_channels(int num_channels, char filenames[][CHANNEL_FILENAME_MAX])
 {
     if (data.initialized) {
@@ -156,7 +401,7 @@ void sound_device_init_channels(int num_channels, char filenames[][CHANNEL_FILEN
         Mix_AllocateChannels(num_channels);
         log_info("Loading audio files", 0, 0);
         for (int i = 0; i < num_channels; i++) {
-            data.channels[i].chunk = 0;
+            sound_device_stop_channel(i);
             data.channels[i].filename = filenames[i][0] ? filenames[i] : 0;
         }
     }
@@ -174,8 +419,9 @@ void sound_device_set_music_volume(int volume_pct)
 
 void sound_device_set_channel_volume(int channel, int volume_pct)
 {
+    // chunks are shared between channels, so the volume is set on the channel
     if (data.channels[channel].chunk) {
-        Mix_VolumeChunk(data.channels[channel].chunk, percentage_to_volume(volume_pct));
+        Mix_Volume(channel, percentage_to_volume(volume_pct));
     }
 }
 
@@ -247,7 +493,7 @@ void sound_device_play_file_on_channel(const char *filename, int channel, int vo
 {
     if (data.initialized && config_get(CONFIG_GENERAL_ENABLE_AUDIO)) {
         sound_device_stop_channel(channel);
-        data.channels[channel].chunk = load_chunk(filename);
+        set_channel_chunk(&data.channels[channel], acquire_chunk(filename));
         if (data.channels[channel].chunk) {
             sound_device_set_channel_volume(channel, volume_pct);
             Mix_PlayChannel(channel, data.channels[channel].chunk, 0);
@@ -295,8 +541,8 @@ void sound_device_stop_channel(int channel)
         sound_channel *ch = &data.channels[channel];
         if (ch->chunk) {
             Mix_HaltChannel(channel);
-            Mix_FreeChunk(ch->chunk);
-            ch->chunk = 0;
+            release_chunk(ch->cached);
+            set_channel_chunk(ch, 0);
         }
     }
 }
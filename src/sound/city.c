@@ -201,6 +201,8 @@ void sound_city_init(void)
     channels[62].channel = SOUND_CHANNEL_CITY_RIVER;
     channels[63].channel = SOUND_CHANNEL_CITY_MISSION_POST;
     channels[64].channel = SOUND_CHANNEL_CITY_CONSTRUCTION_SITE;
+
+    sound_device_preload_channels(SOUND_CHANNEL_CITY_MIN, SOUND_CHANNEL_CITY_MAX);
 }
 
 void sound_city_set_volume(int percentage)
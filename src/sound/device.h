@@ -7,6 +7,15 @@ void sound_device_open(void);
 void sound_device_close(void);
 
 void sound_device_init_channels(int num_channels, char filenames[][CHANNEL_FILENAME_MAX]);
+
+/**
+ * Loads the sounds of a range of channels on a background thread, so that playing them does not wait for the disk.
+ * A preload that is still running is stopped first.
+ * @param first_channel First channel to load
+ * @param last_channel Last channel to load, inclusive
+ */
+void sound_device_preload_channels(int first_channel, int last_channel);
+
 int sound_device_is_channel_playing(int channel);
 
 void sound_device_set_music_volume(int volume_pct);
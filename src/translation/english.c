@@ -837,7 +837,8 @@ static translation_string all_strings[] = {
     {TR_CHEAT_FINISHED_MONUMENTS, "Monuments finished"},
     {TR_CHEAT_UPDATED_MONUMENTS, "Monuments updated"},
     {TR_CHEAT_UNLOCKED_ALL_BUILDINGS, "All buildings unlocked"},
-    {TR_CHEAT_INCITED_RIOT, "Incited a riot"}
+    {TR_CHEAT_INCITED_RIOT, "Incited a riot"},
+    {TR_GAME_SPEED_TURBO, "Turbo"}
 };
 
 void translation_english(const translation_string **strings, int *num_strings)
@@ -832,6 +832,7 @@ typedef enum {
     TR_CHEAT_UPDATED_MONUMENTS,
     TR_CHEAT_UNLOCKED_ALL_BUILDINGS,
     TR_CHEAT_INCITED_RIOT,
+    TR_GAME_SPEED_TURBO,
     TRANSLATION_MAX_KEY
 } translation_key;
 
@@ -14,6 +14,7 @@
 #include "core/string.h"
 #include "figure/formation_legion.h"
 #include "game/cheats.h"
+#include "game/replay.h"
 #include "game/settings.h"
 #include "game/state.h"
 #include "graphics/button.h"
@@ -670,8 +671,10 @@ static void military_map_click(int legion_formation_id, const map_tile *tile)
     int other_formation_id = formation_legion_at_building(tile->grid_offset);
     if (other_formation_id && other_formation_id == legion_formation_id) {
         formation_legion_return_home(m);
+        game_replay_record(REPLAY_COMMAND_LEGION_RETURN_HOME, legion_formation_id, 0, 0);
     } else {
         formation_legion_move_to(m, tile->x, tile->y);
+        game_replay_record(REPLAY_COMMAND_LEGION_MOVE, legion_formation_id, tile->x, tile->y);
         sound_speech_play_file("wavs/cohort5.wav");
     }
     window_city_show();
@@ -10,6 +10,7 @@
 #include "core/log.h"
 #include "game/resource.h"
 #include "game/state.h"
+#include "game/time.h"
 #include "graphics/graphics.h"
 #include "graphics/image.h"
 #include "graphics/renderer.h"
@@ -34,9 +35,27 @@
 #include "widget/city_overlay_risks.h"
 #include "widget/city_without_overlay.h"
 
+#include <string.h>
+
+typedef struct {
+    int building_id;
+    uint16_t generation;
+    uint8_t building_type;
+    uint8_t building_state;
+    uint8_t show_building;
+    int16_t column_height;
+} overlay_value;
+
 static const city_overlay *overlay = 0;
 static float scale = SCALE_NONE;
 
+static struct {
+    int overlay_type;
+    int day;
+    uint16_t generation;
+    overlay_value values[GRID_SIZE * GRID_SIZE];
+} cache;
+
 #define OFFSET(x,y) (x + GRID_SIZE * y)
 
 static const int ADJACENT_OFFSETS[2][4][7] = {
@@ -139,6 +158,52 @@ void city_with_overlay_update(void)
     select_city_overlay();
 }
 
+void city_with_overlay_reset_cache(void)
+{
+    cache.overlay_type = OVERLAY_NONE;
+    cache.day = 0;
+    cache.generation = 0;
+    memset(cache.values, 0, sizeof(cache.values));
+}
+
+static void update_overlay_cache(void)
+{
+    int day = (game_time_year() * 12 + game_time_month()) * 16 + game_time_day();
+    if (cache.overlay_type == overlay->type && cache.day == day && cache.generation) {
+        return;
+    }
+    cache.overlay_type = overlay->type;
+    cache.day = day;
+    if (!++cache.generation) {
+        memset(cache.values, 0, sizeof(cache.values));
+        cache.generation = 1;
+    }
+}
+
+/**
+ * Returns the overlay values for the building at the tile, calculating them at most once per game day.
+ * The building type and state are part of the key so that placing, deleting or mothballing a building
+ * is visible right away, even when the game is paused.
+ */
+static const overlay_value *get_overlay_value(int grid_offset, building *b)
+{
+    overlay_value *value = &cache.values[grid_offset];
+    if (value->generation == cache.generation && value->building_id == b->id &&
+        value->building_type == b->type && value->building_state == b->state) {
+        return value;
+    }
+    if (overlay->type == OVERLAY_PROBLEMS) {
+        city_overlay_problems_prepare_building(b);
+    }
+    value->generation = cache.generation;
+    value->building_id = b->id;
+    value->building_type = b->type;
+    value->building_state = b->state;
+    value->show_building = overlay->show_building(b);
+    value->column_height = value->show_building ? NO_COLUMN : overlay->get_column_height(b);
+    return value;
+}
+
 static int is_drawable_farmhouse(int grid_offset, int map_orientation)
 {
     if (!map_property_is_draw_tile(grid_offset)) {
@@ -327,10 +392,7 @@ void city_with_overlay_draw_building_footprint(int x, int y, int grid_offset, in
         return;
     }
     building *b = building_get(building_id);
-    if (overlay->type == OVERLAY_PROBLEMS) {
-        city_overlay_problems_prepare_building(b);
-    }
-    if (overlay->show_building(b)) {
+    if (get_overlay_value(grid_offset, b)->show_building) {
         if (building_is_farm(b->type)) {
             if (is_drawable_farmhouse(grid_offset, city_view_orientation())) {
                 image_draw_isometric_footprint_from_draw_tile(map_image_at(grid_offset), x, y, 0, scale);
@@ -472,10 +534,11 @@ static void draw_building_top(int grid_offset, building *b, int x, int y)
 void city_with_overlay_draw_building_top(int x, int y, int grid_offset)
 {
     building *b = building_get(map_building_at(grid_offset));
-    if (overlay->show_building(b)) {
+    const overlay_value *value = get_overlay_value(grid_offset, b);
+    if (value->show_building) {
         draw_building_top(grid_offset, b, x, y);
     } else {
-        int column_height = overlay->get_column_height(b);
+        int column_height = value->column_height;
         if (column_height != NO_COLUMN) {
             int draw = 1;
             if (building_is_farm(b->type)) {
@@ -643,6 +706,7 @@ void city_with_overlay_draw(const map_tile *tile)
     }
 
     scale = city_view_get_scale() / 100.0f;
+    update_overlay_cache();
 
     int x, y, width, height;
     city_view_get_viewport(&x, &y, &width, &height);
@@ -9,6 +9,11 @@
  */
 void city_with_overlay_update(void);
 
+/**
+ * Forget the cached overlay values, to be called when a different city is loaded
+ */
+void city_with_overlay_reset_cache(void);
+
 void city_with_overlay_draw(const map_tile *tile);
 
 int city_with_overlay_get_tooltip_text(tooltip_context *c, int grid_offset);
@@ -28,6 +28,32 @@ enum {
     FIGURE_COLOR_WOLF = 4
 };
 
+enum {
+    TILE_TYPE_NONE = 0,
+    TILE_TYPE_ROAD = 1,
+    TILE_TYPE_WATER = 2,
+    TILE_TYPE_TREE = 6,
+    TILE_TYPE_ROCK = 10,
+    TILE_TYPE_AQUEDUCT = 14,
+    TILE_TYPE_WALL = 15,
+    TILE_TYPE_MEADOW = 16,
+    TILE_TYPE_GARDEN = 20,
+    TILE_TYPE_GRASS = 21,
+    TILE_TYPE_BUILDING = 64,
+    TILE_TYPE_BUILDING_SIZES = 8
+};
+
+enum {
+    BUILDING_COLORS_BUILDING = 0,
+    BUILDING_COLORS_HOUSE = 1,
+    BUILDING_COLORS_WATER_STRUCTURE = 2,
+    BUILDING_COLORS_MONUMENT = 3,
+    BUILDING_COLORS_FARM = 4,
+    BUILDING_COLORS_INDUSTRY = 5,
+    BUILDING_COLORS_MILITARY = 6,
+    BUILDING_COLORS_AESTHETICS = 7
+};
+
 typedef struct {
     color_t left;
     color_t right;
@@ -137,6 +163,17 @@ static struct {
     .military        = { .edges = {0xff4e4e4e, 0xffb6b8b8}, .center = {0xff8c8c8c, 0xff6d6e6e} }
 };
 
+static const building_tile_color *BUILDING_COLORS[] = {
+    &minimap_colors.building,
+    &minimap_colors.house,
+    &minimap_colors.water_structure,
+    &minimap_colors.monument,
+    &minimap_colors.farm,
+    &minimap_colors.industry,
+    &minimap_colors.military,
+    &minimap_colors.aesthetics
+};
+
 static struct {
     struct {
         int x;
@@ -161,6 +198,7 @@ static struct {
         color_t *buffer;
     } cache;
     const minimap_functions *functions;
+    uint8_t *tile_types;
     struct {
         int x;
         int y;
@@ -338,13 +376,13 @@ static int building_is_water_structure(building_type type)
     return type == BUILDING_RESERVOIR || type == BUILDING_FOUNTAIN || type == BUILDING_WELL;
 }
 
-static void draw_building(int x_offset, int y_offset, int grid_offset)
+static int get_building_tile_type(int grid_offset)
 {
     if (!data.functions->offset.is_draw_tile(grid_offset)) {
-        return;
+        return TILE_TYPE_NONE;
     }
 
-    const building_tile_color *colors = &minimap_colors.building;
+    int colors = BUILDING_COLORS_BUILDING;
     int size = data.functions->offset.tile_size(grid_offset);
 
     if (data.functions->building) {
@@ -352,26 +390,59 @@ static void draw_building(int x_offset, int y_offset, int grid_offset)
 
         // Palisades are drawn like walls
         if (b->type == BUILDING_PALISADE) {
-            draw_tile(x_offset, y_offset, &minimap_colors.wall);
-            return;
+            return TILE_TYPE_WALL;
         }
 
         if (b->house_size) {
-            colors = &minimap_colors.house;
+            colors = BUILDING_COLORS_HOUSE;
         } else if (building_is_water_structure(b->type)) {
-            colors = &minimap_colors.water_structure;
+            colors = BUILDING_COLORS_WATER_STRUCTURE;
         } else if (building_monument_is_monument(b)) {
-            colors = &minimap_colors.monument;
+            colors = BUILDING_COLORS_MONUMENT;
         } else if (building_is_farm(b->type)) {
-            colors = &minimap_colors.farm;
+            colors = BUILDING_COLORS_FARM;
         } else if (building_is_industry(b->type)) {
-            colors = &minimap_colors.industry;
+            colors = BUILDING_COLORS_INDUSTRY;
         } else if (building_is_military(b->type)) {
-            colors = &minimap_colors.military;
+            colors = BUILDING_COLORS_MILITARY;
         } else if (building_is_aesthetic(b->type)) {
-            colors = &minimap_colors.aesthetics;
-        } 
+            colors = BUILDING_COLORS_AESTHETICS;
+        }
+    }
+    return TILE_TYPE_BUILDING + colors * TILE_TYPE_BUILDING_SIZES + size;
+}
+
+static int get_tile_type(int grid_offset)
+{
+    int terrain = data.functions->offset.terrain(grid_offset);
+
+    if (terrain & TERRAIN_BUILDING) {
+        return get_building_tile_type(grid_offset);
+    }
+    int rand = data.functions->offset.random(grid_offset);
+    if (terrain & TERRAIN_ROAD) {
+        return TILE_TYPE_ROAD;
+    } else if (terrain & TERRAIN_WATER) {
+        return TILE_TYPE_WATER + (rand & 3);
+    } else if (terrain & (TERRAIN_SHRUB | TERRAIN_TREE)) {
+        return TILE_TYPE_TREE + (rand & 3);
+    } else if (terrain & (TERRAIN_ROCK | TERRAIN_ELEVATION)) {
+        return TILE_TYPE_ROCK + (rand & 3);
+    } else if (terrain & TERRAIN_AQUEDUCT) {
+        return TILE_TYPE_AQUEDUCT;
+    } else if (terrain & TERRAIN_WALL) {
+        return TILE_TYPE_WALL;
+    } else if (terrain & TERRAIN_MEADOW) {
+        return TILE_TYPE_MEADOW + (rand & 3);
+    } else if (terrain & TERRAIN_GARDEN) {
+        return TILE_TYPE_GARDEN;
+    } else {
+        return TILE_TYPE_GRASS + (rand & 7);
     }
+}
+
+static void draw_building(int x_offset, int y_offset, const building_tile_color *colors, int size)
+{
     if (size == 1) {
         // The 1x1 house image is inverted for some reason
         if (colors == &minimap_colors.house) {
@@ -420,45 +491,55 @@ static void draw_building(int x_offset, int y_offset, int grid_offset)
     }
 }
 
-static void draw_minimap_tile(int x_view, int y_view, int grid_offset)
+static void draw_tile_type(int x_view, int y_view, int type)
 {
-    if (grid_offset < 0) {
-        return;
-    }
-
-    if (draw_figure(x_view, y_view, grid_offset)) {
+    if (type >= TILE_TYPE_BUILDING) {
+        type -= TILE_TYPE_BUILDING;
+        draw_building(x_view, y_view,
+            BUILDING_COLORS[type / TILE_TYPE_BUILDING_SIZES], type % TILE_TYPE_BUILDING_SIZES);
         return;
     }
-    int terrain = data.functions->offset.terrain(grid_offset);
-
-    if (terrain & TERRAIN_BUILDING) {
-        draw_building(x_view, y_view, grid_offset);
-        return;
-    }
-    int rand = data.functions->offset.random(grid_offset);
     const tile_color *colors;
-    if (terrain & TERRAIN_ROAD) {
+    if (type == TILE_TYPE_NONE) {
+        return;
+    } else if (type == TILE_TYPE_ROAD) {
         colors = &minimap_colors.climate->road;
-    } else if (terrain & TERRAIN_WATER) {
-        colors = &minimap_colors.climate->water[rand & 3];
-    } else if (terrain & (TERRAIN_SHRUB | TERRAIN_TREE)) {
-        colors = &minimap_colors.climate->tree[rand & 3];
-    } else if (terrain & (TERRAIN_ROCK | TERRAIN_ELEVATION)) {
-        colors = &minimap_colors.climate->rock[rand & 3];
-    } else if (terrain & TERRAIN_AQUEDUCT) {
+    } else if (type < TILE_TYPE_TREE) {
+        colors = &minimap_colors.climate->water[type - TILE_TYPE_WATER];
+    } else if (type < TILE_TYPE_ROCK) {
+        colors = &minimap_colors.climate->tree[type - TILE_TYPE_TREE];
+    } else if (type < TILE_TYPE_AQUEDUCT) {
+        colors = &minimap_colors.climate->rock[type - TILE_TYPE_ROCK];
+    } else if (type == TILE_TYPE_AQUEDUCT) {
         colors = &minimap_colors.aqueduct;
-    } else if (terrain & TERRAIN_WALL) {
+    } else if (type == TILE_TYPE_WALL) {
         colors = &minimap_colors.wall;
-    } else if (terrain & TERRAIN_MEADOW) {
-        colors = &minimap_colors.climate->meadow[rand & 3];
-    } else if (terrain & TERRAIN_GARDEN) {
+    } else if (type < TILE_TYPE_GARDEN) {
+        colors = &minimap_colors.climate->meadow[type - TILE_TYPE_MEADOW];
+    } else if (type == TILE_TYPE_GARDEN) {
         colors = &minimap_colors.aesthetics.edges;
     } else {
-        colors = &minimap_colors.climate->grass[rand & 7];
+        colors = &minimap_colors.climate->grass[type - TILE_TYPE_GRASS];
     }
     draw_tile(x_view, y_view, colors);
 }
 
+static void draw_minimap_tile(int x_view, int y_view, int grid_offset)
+{
+    if (grid_offset < 0) {
+        return;
+    }
+
+    if (draw_figure(x_view, y_view, grid_offset)) {
+        return;
+    }
+    if (data.functions->offset.tile_type) {
+        draw_tile_type(x_view, y_view, data.functions->offset.tile_type(grid_offset));
+    } else {
+        draw_tile_type(x_view, y_view, get_tile_type(grid_offset));
+    }
+}
+
 static void draw_viewport_rectangle(void)
 {
     int x_offset = (int) ((2 * (data.viewport.x - data.minimap.x) - 2 / 30) / data.minimap.scale);
@@ -477,15 +558,21 @@ static void draw_viewport_rectangle(void)
         COLOR_MINIMAP_VIEWPORT);
 }
 
-static void prepare_minimap_cache(void)
+static int set_minimap_size(void)
 {
-    if (data.functions->map.width() != data.minimap.width || data.functions->map.height() * 2 != data.minimap.height ||
-        !graphics_renderer()->has_custom_image(CUSTOM_IMAGE_MINIMAP)) {
-        data.minimap.width = data.functions->map.width();
-        data.minimap.height = data.functions->map.height() * 2;
-        data.minimap.x = (VIEW_X_MAX - data.minimap.width) / 2;
-        data.minimap.y = (VIEW_Y_MAX - data.minimap.height) / 2;
+    if (data.functions->map.width() == data.minimap.width && data.functions->map.height() * 2 == data.minimap.height) {
+        return 0;
+    }
+    data.minimap.width = data.functions->map.width();
+    data.minimap.height = data.functions->map.height() * 2;
+    data.minimap.x = (VIEW_X_MAX - data.minimap.width) / 2;
+    data.minimap.y = (VIEW_Y_MAX - data.minimap.height) / 2;
+    return 1;
+}
 
+static void prepare_minimap_cache(void)
+{
+    if (set_minimap_size() || !graphics_renderer()->has_custom_image(CUSTOM_IMAGE_MINIMAP)) {
         graphics_renderer()->create_custom_image(CUSTOM_IMAGE_MINIMAP, data.minimap.width * 2, data.minimap.height, 0);
     }
     data.cache.buffer = graphics_renderer()->get_custom_image_buffer(CUSTOM_IMAGE_MINIMAP, &data.cache.stride);
@@ -509,6 +596,31 @@ void widget_minimap_update(const minimap_functions *functions)
     graphics_renderer()->update_custom_image(CUSTOM_IMAGE_MINIMAP);
 }
 
+static void store_tile_type(int x_view, int y_view, int grid_offset)
+{
+    if (grid_offset >= 0) {
+        data.tile_types[grid_offset] = get_tile_type(grid_offset);
+    }
+}
+
+void widget_minimap_store_tile_types(const minimap_functions *functions, uint8_t *tile_types)
+{
+    const minimap_functions *previous_functions = data.functions;
+    int width = data.minimap.width;
+    int height = data.minimap.height;
+    data.functions = functions;
+    data.tile_types = tile_types;
+    set_minimap_size();
+    foreach_map_tile(store_tile_type);
+    data.tile_types = 0;
+    data.functions = previous_functions;
+    // keep the size of the cached minimap image in sync with its contents
+    data.minimap.width = width;
+    data.minimap.height = height;
+    data.minimap.x = (VIEW_X_MAX - width) / 2;
+    data.minimap.y = (VIEW_Y_MAX - height) / 2;
+}
+
 void widget_minimap_draw(int x_offset, int y_offset, int width, int height)
 {
     if (!data.cache.buffer) {
@@ -6,6 +6,8 @@
 #include "input/mouse.h"
 #include "scenario/property.h"
 
+#include <stdint.h>
+
 typedef struct {
     scenario_climate(*climate)(void);
     building *(*building)(int id);
@@ -20,6 +22,7 @@ typedef struct {
         int (*is_draw_tile)(int grid_offset);
         int (*tile_size)(int grid_offset);
         int (*random)(int grid_offset);
+        int (*tile_type)(int grid_offset);
     } offset;
     void (*viewport)(int *x, int *y, int *width, int *height);
 } minimap_functions;
@@ -28,6 +31,14 @@ void widget_minimap_invalidate(void);
 
 void widget_minimap_update(const minimap_functions *functions);
 
+/**
+ * Stores the minimap tile type of every tile of a map, so the minimap can be drawn later without the map data
+ * by providing the stored types through the tile_type function. Figures are not included.
+ * @param functions Functions to access the map
+ * @param tile_types Out: tile type for each grid offset
+ */
+void widget_minimap_store_tile_types(const minimap_functions *functions, uint8_t *tile_types);
+
 void widget_minimap_draw(int x_offset, int y_offset, int width, int height);
 
 void widget_minimap_draw_decorated(int x_offset, int y_offset, int width, int height);
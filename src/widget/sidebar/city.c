@@ -7,6 +7,7 @@
 #include "core/config.h"
 #include "core/direction.h"
 #include "game/orientation.h"
+#include "game/replay.h"
 #include "game/state.h"
 #include "game/undo.h"
 #include "graphics/graphics.h"
@@ -303,6 +304,7 @@ static void button_build(int submenu, int param2)
 static void button_undo(int param1, int param2)
 {
     window_build_menu_hide();
+    game_replay_record(REPLAY_COMMAND_UNDO, 0, 0, 0);
     game_undo_perform();
     window_invalidate();
 }
@@ -350,6 +352,7 @@ static void button_toggle_grid(int param1, int param2)
 static void button_rotate_north(int param1, int param2)
 {
     game_orientation_rotate_north();
+    game_replay_record(REPLAY_COMMAND_ROTATE_MAP, REPLAY_ROTATE_MAP_NORTH, 0, 0);
     window_invalidate();
 }
 
@@ -357,9 +360,11 @@ static void button_rotate(int clockwise, int param2)
 {
     if (clockwise) {
         game_orientation_rotate_right();
+        game_replay_record(REPLAY_COMMAND_ROTATE_MAP, REPLAY_ROTATE_MAP_RIGHT, 0, 0);
     }
     else {
         game_orientation_rotate_left();
+        game_replay_record(REPLAY_COMMAND_ROTATE_MAP, REPLAY_ROTATE_MAP_LEFT, 0, 0);
     }
     window_invalidate();
 }
@@ -17,6 +17,7 @@
 #include "figure/formation_legion.h"
 #include "game/resource.h"
 #include "game/settings.h"
+#include "game/speed.h"
 #include "game/state.h"
 #include "graphics/arrow_button.h"
 #include "graphics/button.h"
@@ -97,6 +98,7 @@ static struct {
     int is_collapsed;
     sidebar_extra_display info_to_display;
     int game_speed;
+    int ticks_per_second;
     struct {
         int percentage;
         int amount;
@@ -294,6 +296,9 @@ static int update_extra_info(int is_background)
     int changed = 0;
     if (data.info_to_display & SIDEBAR_EXTRA_DISPLAY_GAME_SPEED) {
         changed |= update_extra_info_value(setting_game_speed(), &data.game_speed);
+        if (data.game_speed == SETTING_GAME_SPEED_TURBO) {
+            changed |= update_extra_info_value(game_speed_get_ticks_per_second(), &data.ticks_per_second);
+        }
     }
     if (data.info_to_display & SIDEBAR_EXTRA_DISPLAY_UNEMPLOYMENT) {
         changed |= update_extra_info_value(city_labor_unemployment_percentage(), &data.unemployment.percentage);
@@ -522,7 +527,14 @@ static void draw_extra_info_panel(void)
         lang_text_draw(45, 2, data.x_offset + 10, y_offset, FONT_NORMAL_WHITE);
         y_offset += EXTRA_INFO_LINE_SPACE + EXTRA_INFO_VERTICAL_PADDING;
 
-        text_draw_percentage(data.game_speed, data.x_offset + 60, y_offset - 2, FONT_NORMAL_GREEN);
+        if (data.game_speed == SETTING_GAME_SPEED_TURBO) {
+            int width = text_draw(translation_for(TR_GAME_SPEED_TURBO),
+                data.x_offset + 10, y_offset - 2, FONT_NORMAL_GREEN, 0);
+            text_draw_number(data.ticks_per_second, '@', "/s",
+                data.x_offset + 10 + width, y_offset - 2, FONT_NORMAL_GREEN, 0);
+        } else {
+            text_draw_percentage(data.game_speed, data.x_offset + 60, y_offset - 2, FONT_NORMAL_GREEN);
+        }
 
         y_offset += EXTRA_INFO_VERTICAL_PADDING * 3;
     }
@@ -5,6 +5,7 @@
 #include "core/calc.h"
 #include "figure/formation.h"
 #include "figure/formation_legion.h"
+#include "game/replay.h"
 #include "graphics/arrow_button.h"
 #include "graphics/generic_button.h"
 #include "graphics/graphics.h"
@@ -594,6 +595,7 @@ static void button_select_formation_layout(int index, int param2)
         layout_indexes = LAYOUT_BUTTON_INDEXES_AUXILIARY[swap_lines];
     }
     formation_legion_change_layout(m, layout_indexes[index]);
+    game_replay_record(REPLAY_COMMAND_LEGION_LAYOUT, m->id, layout_indexes[index], 0);
     switch (index) {
         case 0: sound_speech_play_file("wavs/cohort1.wav"); break;
         case 1: sound_speech_play_file("wavs/cohort2.wav"); break;
@@ -614,6 +616,7 @@ static void button_return_to_fort(int param1, int param2)
     formation *m = formation_get(data.active_legion.formation_id);
     if (!m->in_distant_battle) {
         formation_legion_return_home(m);
+        game_replay_record(REPLAY_COMMAND_LEGION_RETURN_HOME, m->id, 0, 0);
     }
 }
 
@@ -621,4 +624,5 @@ static void button_empire_service(int param1, int param2)
 {
     formation_toggle_empire_service(data.active_legion.formation_id);
     formation_calculate_figures();
+    game_replay_record(REPLAY_COMMAND_LEGION_EMPIRE_SERVICE, data.active_legion.formation_id, 0, 0);
 }
@@ -3,6 +3,7 @@
 #include "city/data_private.h"
 #include "city/finance.h"
 #include "core/calc.h"
+#include "game/replay.h"
 #include "graphics/arrow_button.h"
 #include "graphics/graphics.h"
 #include "graphics/image.h"
@@ -117,6 +118,7 @@ static int handle_mouse(const mouse *m)
 static void button_change_taxes(int is_down, int param2)
 {
     city_finance_change_tax_percentage(is_down ? -1 : 1);
+    game_replay_record(REPLAY_COMMAND_TAXES, is_down ? -1 : 1, 0, 0);
     city_finance_estimate_taxes();
     city_finance_calculate_totals();
     window_invalidate();
@@ -6,6 +6,7 @@
 #include "city/view.h"
 #include "core/calc.h"
 #include "figure/formation_legion.h"
+#include "game/replay.h"
 #include "graphics/generic_button.h"
 #include "graphics/image.h"
 #include "graphics/lang_text.h"
@@ -254,6 +255,7 @@ static void return_legion_to_fort(int legion_id)
     formation *m = formation_get(formation_for_legion(legion_id));
     if (!m->in_distant_battle && !m->is_at_fort) {
         formation_legion_return_home(m);
+        game_replay_record(REPLAY_COMMAND_LEGION_RETURN_HOME, m->id, 0, 0);
         window_invalidate();
     }
 }
@@ -268,6 +270,7 @@ static void button_empire_service(int legion_id, int param2)
     int formation_id = formation_for_legion(legion_id + scrollbar.scroll_position);
     formation_toggle_empire_service(formation_id);
     formation_calculate_figures();
+    game_replay_record(REPLAY_COMMAND_LEGION_EMPIRE_SERVICE, formation_id, 0, 0);
     window_invalidate();
 }
 
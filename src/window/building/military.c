@@ -11,6 +11,7 @@
 #include "core/log.h"
 #include "core/string.h"
 #include "figure/formation_legion.h"
+#include "game/replay.h"
 #include "graphics/generic_button.h"
 #include "graphics/image.h"
 #include "graphics/lang_text.h"
@@ -519,6 +520,7 @@ static void button_return_to_fort(int param1, int param2)
     formation *m = formation_get(data.context_for_callback->formation_id);
     if (!m->in_distant_battle && m->is_at_fort != 1) {
         formation_legion_return_home(m);
+        game_replay_record(REPLAY_COMMAND_LEGION_RETURN_HOME, m->id, 0, 0);
         window_city_show();
     }
 }
@@ -555,6 +557,7 @@ static void button_layout(int index, int param2)
         }
     }
     formation_legion_change_layout(m, new_layout);
+    game_replay_record(REPLAY_COMMAND_LEGION_LAYOUT, m->id, new_layout, 0);
     switch (index) {
         case 0: sound_speech_play_file("wavs/cohort1.wav"); break;
         case 1: sound_speech_play_file("wavs/cohort2.wav"); break;
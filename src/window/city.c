@@ -16,6 +16,7 @@
 #include "figure/formation.h"
 #include "figure/formation_legion.h"
 #include "game/orientation.h"
+#include "game/replay.h"
 #include "game/settings.h"
 #include "game/state.h"
 #include "game/time.h"
@@ -456,18 +457,21 @@ static void handle_hotkeys(const hotkeys *h)
     if (h->rotate_map_left) {
         if (!building_construction_in_progress()) {
             game_orientation_rotate_left();
+            game_replay_record(REPLAY_COMMAND_ROTATE_MAP, REPLAY_ROTATE_MAP_LEFT, 0, 0);
             window_invalidate();
         }
     }
     if (h->rotate_map_right) {
         if (!building_construction_in_progress()) {
             game_orientation_rotate_right();
+            game_replay_record(REPLAY_COMMAND_ROTATE_MAP, REPLAY_ROTATE_MAP_RIGHT, 0, 0);
             window_invalidate();
         }
     }
     if (h->rotate_map_north) {
         if (!building_construction_in_progress()) {
             game_orientation_rotate_north();
+            game_replay_record(REPLAY_COMMAND_ROTATE_MAP, REPLAY_ROTATE_MAP_NORTH, 0, 0);
             window_invalidate();
         }
     }
@@ -495,6 +499,7 @@ static void handle_hotkeys(const hotkeys *h)
         set_construction_building_type(h->building);
     }
     if (h->undo) {
+        game_replay_record(REPLAY_COMMAND_UNDO, 0, 0, 0);
         game_undo_perform();
         window_invalidate();
     }
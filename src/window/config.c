@@ -253,7 +253,9 @@ static const resolution resolutions[] = {
     { 2560, 1440 }, { 3440, 1440 }, { 3840, 2160 }
 };
 
-static const int game_speeds[] = { 10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 200, 300, 400, 500 };
+static const int game_speeds[] = {
+    10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 200, 300, 400, 500, SETTING_GAME_SPEED_TURBO
+};
 
 static resolution available_resolutions[sizeof(resolutions) / sizeof(resolution) + 2];
 
@@ -262,7 +264,7 @@ static generic_button select_buttons[] = {
 };
 
 static numerical_range_widget ranges[] = {
-    { 50, 30,   0,  13,  1, 0},
+    { 50, 30,   0,  14,  1, 0},
     { 98, 27,   0,   0,  1, 0},
     { 50, 30,  50, 500,  5, 0},
     { 50, 30, 100, 200, 50, 0},
@@ -610,7 +612,11 @@ static const uint8_t *display_text_language(void)
 
 static const uint8_t *display_text_game_speed(void)
 {
-    return percentage_string(display_text, game_speeds[data.config_values[CONFIG_ORIGINAL_GAME_SPEED].new_value]);
+    int game_speed = game_speeds[data.config_values[CONFIG_ORIGINAL_GAME_SPEED].new_value];
+    if (game_speed == SETTING_GAME_SPEED_TURBO) {
+        return translation_for(TR_GAME_SPEED_TURBO);
+    }
+    return percentage_string(display_text, game_speed);
 }
 
 static const uint8_t *display_text_resolution(void)
@@ -11,6 +11,7 @@
 #include "game/file.h"
 #include "game/file_editor.h"
 #include "game/file_io.h"
+#include "game/savegame_index.h"
 #include "graphics/generic_button.h"
 #include "graphics/graphics.h"
 #include "graphics/image.h"
@@ -308,6 +309,13 @@ static int should_scroll_to_typed_text(void)
     return scroll;
 }
 
+static void close_dialog(void)
+{
+    input_box_stop(&file_name_input);
+    // write the index entries of all saved games shown while the dialog was open at once
+    savegame_index_write_changes();
+}
+
 static void handle_input(const mouse *m, const hotkeys *h)
 {
     data.double_click = m->left.double_click;
@@ -335,7 +343,7 @@ static void handle_input(const mouse *m, const hotkeys *h)
         return;
     }
     if (input_go_back_requested(m, h)) {
-        input_box_stop(&file_name_input);
+        close_dialog();
         window_go_back();
         return;
     }
@@ -369,7 +377,7 @@ static char *get_chosen_filename(void)
 static void button_ok_cancel(int is_ok, int param2)
 {
     if (!is_ok) {
-        input_box_stop(&file_name_input);
+        close_dialog();
         window_go_back();
         return;
     }
@@ -384,7 +392,7 @@ static void button_ok_cancel(int is_ok, int param2)
         if (data.type == FILE_TYPE_SAVED_GAME) {
             int result = game_file_load_saved_game(filename);
             if (result == 1) {
-                input_box_stop(&file_name_input);
+                close_dialog();
                 window_city_show();
             } else if (result == 0) {
                 data.message_not_exist_start_time = time_get_millis();
@@ -396,7 +404,7 @@ static void button_ok_cancel(int is_ok, int param2)
             }
         } else if (data.type == FILE_TYPE_SCENARIO) {
             if (game_file_editor_load_scenario(filename)) {
-                input_box_stop(&file_name_input);
+                close_dialog();
                 window_editor_map_show();
             } else {
                 data.message_not_exist_start_time = time_get_millis();
@@ -404,7 +412,7 @@ static void button_ok_cancel(int is_ok, int param2)
             }
         }
     } else if (data.dialog_type == FILE_DIALOG_SAVE) {
-        input_box_stop(&file_name_input);
+        close_dialog();
         if (data.type == FILE_TYPE_SAVED_GAME) {
             if (!file_has_extension(filename, saved_game_data_expanded.extension)) {
                 file_append_extension(filename, saved_game_data_expanded.extension);
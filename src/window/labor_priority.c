@@ -1,6 +1,7 @@
 #include "labor_priority.h"
 
 #include "city/labor.h"
+#include "game/replay.h"
 #include "graphics/generic_button.h"
 #include "graphics/graphics.h"
 #include "graphics/lang_text.h"
@@ -112,6 +113,7 @@ static void handle_input(const mouse *m, const hotkeys *h)
 static void button_set_priority(int new_priority, int param2)
 {
     city_labor_set_priority(data.category, new_priority);
+    game_replay_record(REPLAY_COMMAND_LABOR_PRIORITY, data.category, new_priority, 0);
     window_go_back();
 }
 
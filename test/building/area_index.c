@@ -0,0 +1,222 @@
+#include "building/building.h"
+#include "building/house.h"
+#include "building/image.h"
+#include "core/calc.h"
+#include "core/config.h"
+#include "core/time.h"
+#include "game/file.h"
+#include "game/game.h"
+#include "game/settings.h"
+#include "map/building_tiles.h"
+#include "map/grid.h"
+#include "map/terrain.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define QUERY_STEP 7
+#define MOVE_EVERY 5
+#define TICKS_BETWEEN_CHECKS 50
+#define NUM_CHECKS 20
+#define NUM_HOUSE_BLOCKS 8
+#define AREA_SIZE 16
+
+static const int MAX_DISTANCES[] = { 10000, 150, 12 };
+#define NUM_MAX_DISTANCES (sizeof(MAX_DISTANCES) / sizeof(int))
+
+static unsigned int random_state;
+
+static unsigned int next_random(void)
+{
+    random_state = random_state * 1103515245 + 12345;
+    return (random_state >> 16) & 0x7fff;
+}
+
+// The scan building_find_closest_of_type replaces
+static building *find_closest_by_scan(building_type type, int x, int y, int max_distance)
+{
+    building *closest = 0;
+    int closest_distance = max_distance;
+    for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
+        if (b->state != BUILDING_STATE_IN_USE) {
+            continue;
+        }
+        int distance = calc_maximum_distance(x, y, b->x, b->y);
+        if (distance < closest_distance) {
+            closest = b;
+            closest_distance = distance;
+        }
+    }
+    return closest;
+}
+
+static int compare_with_scan(const char *step, building_type type, int x, int y, int max_distance, int differences)
+{
+    const building *expected = find_closest_by_scan(type, x, y, max_distance);
+    const building *actual = building_find_closest_of_type(type, x, y, max_distance);
+    if (actual == expected) {
+        return 0;
+    }
+    if (differences < 10) {
+        printf("%s: closest building of type %d to %d,%d within %d is %d, expected %d\n", step,
+            type, x, y, max_distance, actual ? actual->id : 0, expected ? expected->id : 0);
+    }
+    return 1;
+}
+
+/**
+ * Compares the index with the scan for every building type, from tiles all over the map,
+ * and from the tile of every building, which finds buildings that the index keeps in the wrong area
+ * @return The number of differences found
+ */
+static int check_index(const char *step)
+{
+    int differences = 0;
+    for (building_type type = BUILDING_NONE + 1; type < BUILDING_TYPE_MAX; type++) {
+        if (!building_first_of_type(type)) {
+            continue;
+        }
+        for (int y = 0; y < GRID_SIZE; y += QUERY_STEP) {
+            for (int x = 0; x < GRID_SIZE; x += QUERY_STEP) {
+                for (int i = 0; i < NUM_MAX_DISTANCES; i++) {
+                    differences += compare_with_scan(step, type, x, y, MAX_DISTANCES[i], differences);
+                }
+            }
+        }
+        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
+            differences += compare_with_scan(step, type, b->x, b->y, 1, differences);
+        }
+    }
+    return differences;
+}
+
+static int is_clear_area(int x, int y, int size)
+{
+    if (!map_grid_is_inside(x, y, size)) {
+        return 0;
+    }
+    for (int dy = 0; dy < size; dy++) {
+        for (int dx = 0; dx < size; dx++) {
+            if (map_terrain_is(map_grid_offset(x + dx, y + dy), TERRAIN_NOT_CLEAR)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static building *add_tent(int x, int y)
+{
+    building *b = building_create(BUILDING_HOUSE_SMALL_TENT, x, y);
+    b->state = BUILDING_STATE_IN_USE;
+    map_building_tiles_add(b->id, x, y, 1, building_image_get(b), TERRAIN_BUILDING);
+    return b;
+}
+
+/**
+ * Builds blocks of four tents on clear land. The first tent of every other block merges the block,
+ * the last tent of the other blocks expands over the block, which moves it up and left
+ */
+static void merge_and_expand_houses(int *merged, int *expanded)
+{
+    *merged = 0;
+    *expanded = 0;
+    int all_houses_merge = config_get(CONFIG_GP_CH_ALL_HOUSES_MERGE);
+    config_set(CONFIG_GP_CH_ALL_HOUSES_MERGE, 1);
+    int block = 0;
+    // the blocks straddle the areas of the index, so the expanded tents move to another area
+    for (int y = AREA_SIZE - 1; y < GRID_SIZE && block < NUM_HOUSE_BLOCKS; y += AREA_SIZE) {
+        for (int x = AREA_SIZE - 1; x < GRID_SIZE && block < NUM_HOUSE_BLOCKS; x += AREA_SIZE) {
+            // the third row and column stay clear, so the last tent cannot expand down and right
+            if (!is_clear_area(x, y, 3)) {
+                continue;
+            }
+            building *first = add_tent(x, y);
+            add_tent(x + 1, y);
+            add_tent(x, y + 1);
+            building *last = add_tent(x + 1, y + 1);
+            if (block % 2 == 0) {
+                building_house_merge(first);
+                *merged += first->house_is_merged;
+            } else if (building_house_can_expand(last, 4)) {
+                building_house_expand_to_large_insula(last);
+                *expanded += last->x == x && last->y == y;
+            }
+            block++;
+        }
+    }
+    config_set(CONFIG_GP_CH_ALL_HOUSES_MERGE, all_houses_merge);
+}
+
+// Moves some buildings of every type to random tiles
+static int move_buildings(void)
+{
+    int moved = 0;
+    for (building_type type = BUILDING_NONE + 1; type < BUILDING_TYPE_MAX; type++) {
+        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
+            if (next_random() % MOVE_EVERY == 0) {
+                building_set_position(b, next_random() % GRID_SIZE, next_random() % GRID_SIZE);
+                moved++;
+            }
+        }
+    }
+    return moved;
+}
+
+static void run_ticks(int ticks)
+{
+    for (int i = 1; i <= ticks; i++) {
+        time_set_millis(time_get_millis() + 2);
+        game_run();
+    }
+}
+
+/**
+ * Usage: areaindex SAVED_GAME
+ * Checks that the closest building found through the area index is the one a scan of all buildings finds,
+ * while the city runs, after houses merge and expand, and after buildings are moved.
+ */
+int main(int argc, char **argv)
+{
+    if (argc != 2) {
+        printf("Usage: areaindex SAVED_GAME\n");
+        return -1;
+    }
+    if (!game_pre_init() || !game_init()) {
+        printf("Unable to initialize the game\n");
+        return 2;
+    }
+    if (game_file_load_saved_game(argv[1]) != 1) {
+        printf("Unable to load saved game %s\n", argv[1]);
+        return 3;
+    }
+    int differences = check_index("loaded");
+
+    setting_reset_speeds(500, setting_scroll_speed());
+    time_set_millis(0);
+    for (int i = 0; i < NUM_CHECKS; i++) {
+        run_ticks(TICKS_BETWEEN_CHECKS);
+        differences += check_index("running");
+    }
+
+    int merged_houses, large_houses;
+    merge_and_expand_houses(&merged_houses, &large_houses);
+    printf("Merged %d houses, expanded %d houses\n", merged_houses, large_houses);
+    differences += check_index("merged and expanded");
+
+    random_state = 1;
+    printf("Moved %d buildings\n", move_buildings());
+    differences += check_index("moved");
+
+    // no game_exit: it would save the config, which the other tests in this directory read
+
+    if (differences) {
+        printf("%d queries found another building than the scan\n", differences);
+        return 1;
+    }
+    if (merged_houses != NUM_HOUSE_BLOCKS / 2 || large_houses != NUM_HOUSE_BLOCKS / 2) {
+        printf("Not all blocks of tents were merged or expanded\n");
+        return 1;
+    }
+    return 0;
+}
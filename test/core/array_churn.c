@@ -0,0 +1,127 @@
+#include "core/array.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define ARRAY_SIZE_STEP 500
+#define LIVE_ITEMS 20000
+#define CHURN_ROUNDS 200000
+#define HOLD_EVERY 1000
+#define HOLD_ROUNDS 50
+
+typedef struct {
+    int id;
+    int in_use;
+    int held;
+} item;
+
+typedef array(item) item_array;
+
+static unsigned int random_state;
+
+static unsigned int next_random(void)
+{
+    random_state = random_state * 1103515245 + 12345;
+    return (random_state >> 16) & 0x7fff;
+}
+
+static void create_item(item *i, int position)
+{
+    i->id = position;
+}
+
+static int item_in_use(const item *i)
+{
+    return i->in_use || i->held;
+}
+
+static int add_item(item_array *items)
+{
+    item *new_item;
+    array_new_item(*items, 1, new_item);
+    if (!new_item) {
+        return 0;
+    }
+    new_item->in_use = 1;
+    return new_item->id;
+}
+
+static void remove_item(item_array *items, int id, int track_used)
+{
+    array_item(*items, id)->in_use = 0;
+    if (track_used) {
+        array_item_released(*items, id);
+    }
+    array_trim(*items);
+}
+
+/**
+ * Creates and deletes items like figures spawning and dying in a large city.
+ * Some deleted items are held for a while, like buildings kept for undo, and reported once they are let go.
+ * @return A checksum of the positions handed out, which must not depend on the tracking mode
+ */
+static unsigned int run_churn(int rounds, int track_used, double *millis)
+{
+    item_array items = { 0 };
+    if (!array_init(items, ARRAY_SIZE_STEP, create_item, item_in_use) || !array_next(items)) {
+        printf("Unable to allocate the array\n");
+        return 0;
+    }
+    if (track_used) {
+        array_track_used_items(items);
+    }
+    random_state = 1;
+    unsigned int checksum = 0;
+    int held_id = 0;
+    clock_t start = clock();
+    for (int i = 0; i < LIVE_ITEMS; i++) {
+        add_item(&items);
+    }
+    for (int round = 0; round < rounds; round++) {
+        int id = 1 + (next_random() << 15 | next_random()) % (items.size - 1);
+        if (array_item(items, id)->in_use) {
+            if (!held_id && round % HOLD_EVERY == 0) {
+                array_item(items, id)->held = 1;
+                held_id = id;
+            }
+            remove_item(&items, id, track_used);
+        }
+        if (held_id && round % HOLD_EVERY == HOLD_ROUNDS) {
+            array_item(items, held_id)->held = 0;
+            if (track_used) {
+                array_item_released(items, held_id);
+            }
+            held_id = 0;
+        }
+        checksum = checksum * 31 + add_item(&items);
+    }
+    *millis = (clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+    array_clear(items);
+    return checksum;
+}
+
+/**
+ * Usage: arraychurn [ROUNDS]
+ * The default number of rounds is meant for benchmarking, the tests run fewer.
+ */
+int main(int argc, char **argv)
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : CHURN_ROUNDS;
+    if (rounds <= 0) {
+        printf("Invalid number of rounds\n");
+        return -1;
+    }
+    double scan_millis, tracked_millis;
+    unsigned int scan_checksum = run_churn(rounds, 0, &scan_millis);
+    unsigned int tracked_checksum = run_churn(rounds, 1, &tracked_millis);
+
+    printf("Linear scan:   %8.1f ms\n", scan_millis);
+    printf("Tracked items: %8.1f ms\n", tracked_millis);
+
+    if (scan_checksum != tracked_checksum) {
+        printf("Tracked items were given different positions: %u != %u\n", scan_checksum, tracked_checksum);
+        return 1;
+    }
+    return 0;
+}
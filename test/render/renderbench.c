@@ -0,0 +1,196 @@
+#include "software_renderer.h"
+
+#include "city/view.h"
+#include "core/file.h"
+#include "core/time.h"
+#include "game/file.h"
+#include "game/game.h"
+#include "game/state.h"
+#include "graphics/screen.h"
+#include "graphics/window.h"
+#include "map/grid.h"
+#include "platform/file_manager.h"
+#include "widget/city_with_overlay.h"
+#include "window/city.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _MSC_VER
+#include <direct.h>
+#define getcwd _getcwd
+#else
+#include <unistd.h>
+#endif
+
+#define DEFAULT_WIDTH 1280
+#define DEFAULT_HEIGHT 800
+#define DEFAULT_FRAMES 100
+
+static const int ZOOM_LEVELS[] = { 50, 100, 200 };
+#define NUM_ZOOM_LEVELS (int) (sizeof(ZOOM_LEVELS) / sizeof(int))
+
+// One overlay of each kind: plain buildings, columns, coverage and a per-building calculation
+static const struct {
+    int type;
+    const char *name;
+} OVERLAYS[] = {
+    { OVERLAY_NONE, "none" },
+    { OVERLAY_WATER, "water" },
+    { OVERLAY_FIRE, "fire" },
+    { OVERLAY_EDUCATION, "education" },
+    { OVERLAY_DESIRABILITY, "desirability" },
+    { OVERLAY_PROBLEMS, "problems" }
+};
+#define NUM_OVERLAYS (int) (sizeof(OVERLAYS) / sizeof(OVERLAYS[0]))
+
+static uint32_t checksum_screen(void)
+{
+    // FNV-1a
+    const color_t *pixels = software_renderer_get_pixels();
+    int size = screen_width() * screen_height();
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < size; i++) {
+        hash = (hash ^ pixels[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Moves the camera along the diagonal of the map, drawing the full city window at every step
+static void sweep(int scale, int overlay, int frames)
+{
+    city_view_set_scale(scale);
+    game_state_set_overlay(OVERLAYS[overlay].type);
+    city_with_overlay_update();
+    int width = map_grid_width();
+    int height = map_grid_height();
+    software_renderer_reset_images_drawn();
+    clock_t start = clock();
+    for (int i = 0; i < frames; i++) {
+        int x = frames > 1 ? i * (width - 1) / (frames - 1) : width / 2;
+        int y = frames > 1 ? i * (height - 1) / (frames - 1) : height / 2;
+        city_view_go_to_grid_offset(map_grid_offset(x, y));
+        window_draw(1);
+    }
+    double millis = (clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+    printf("  zoom %3d%%, overlay %-12s: %8.3f ms/frame, %8.1f images/frame, checksum %08x\n", scale,
+        OVERLAYS[overlay].name, millis / frames, software_renderer_get_images_drawn() / (double) frames, checksum_screen());
+}
+
+static int run_benchmark(const char *name, const char *saved_game, int frames)
+{
+    if (game_file_load_saved_game(saved_game) != 1) {
+        printf("Unable to load saved game %s\n", name);
+        return 0;
+    }
+    window_city_show();
+    printf("%s\n", name);
+    for (int i = 0; i < NUM_ZOOM_LEVELS; i++) {
+        for (int j = 0; j < NUM_OVERLAYS; j++) {
+            sweep(ZOOM_LEVELS[i], j, frames);
+        }
+    }
+    game_state_set_overlay(OVERLAY_NONE);
+    return 1;
+}
+
+static void to_absolute_path(const char *path, char *result)
+{
+    if (path[0] == '/' || path[0] == '\\' || (path[0] && path[1] == ':') || !getcwd(result, FILE_NAME_MAX)) {
+        snprintf(result, FILE_NAME_MAX, "%s", path);
+        return;
+    }
+    size_t length = strlen(result);
+    snprintf(&result[length], FILE_NAME_MAX - length, "/%s", path);
+}
+
+// The game opens files relative to the data directory, so absolute paths are turned into relative ones
+static void to_path_from_data_directory(char *path)
+{
+    char data_directory[FILE_NAME_MAX];
+    if (path[0] != '/' || !getcwd(data_directory, FILE_NAME_MAX)) {
+        return;
+    }
+    char result[FILE_NAME_MAX] = { 0 };
+    size_t length = 0;
+    for (const char *c = data_directory; *c && length < FILE_NAME_MAX - 3; c++) {
+        if (*c == '/' && c[1]) {
+            memcpy(&result[length], "../", 3);
+            length += 3;
+        }
+    }
+    snprintf(&result[length], FILE_NAME_MAX - length, "%s", &path[1]);
+    memcpy(path, result, FILE_NAME_MAX);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        printf("Usage: renderbench DATA_DIRECTORY SAVED_GAME... [--size WIDTH HEIGHT] [--frames FRAMES]\n");
+        return -1;
+    }
+    int width = DEFAULT_WIDTH;
+    int height = DEFAULT_HEIGHT;
+    int frames = DEFAULT_FRAMES;
+    int num_saved_games = 0;
+    const char **names = malloc(sizeof(*names) * argc);
+    char (*saved_games)[FILE_NAME_MAX] = malloc(sizeof(*saved_games) * argc);
+    if (!names || !saved_games) {
+        free(names);
+        free(saved_games);
+        return -1;
+    }
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--size") == 0 && i + 2 < argc) {
+            width = atoi(argv[++i]);
+            height = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        } else {
+            // the saved games are given relative to where the benchmark is run, not to the data directory
+            names[num_saved_games] = argv[i];
+            to_absolute_path(argv[i], saved_games[num_saved_games++]);
+        }
+    }
+    if (width <= 0 || height <= 0 || frames <= 0 || !num_saved_games) {
+        printf("Invalid arguments\n");
+        return -1;
+    }
+
+    if (!platform_file_manager_set_base_path(argv[1])) {
+        printf("Unable to use %s as the data directory\n", argv[1]);
+        return 1;
+    }
+    for (int i = 0; i < num_saved_games; i++) {
+        to_path_from_data_directory(saved_games[i]);
+    }
+    if (!software_renderer_init(width, height)) {
+        printf("Unable to create a %dx%d framebuffer\n", width, height);
+        return 1;
+    }
+    if (!game_pre_init()) {
+        printf("Unable to run game_pre_init\n");
+        return 1;
+    }
+    screen_set_resolution(width, height);
+    time_set_millis(0);
+    if (!game_init()) {
+        printf("Unable to run game_init\n");
+        return 2;
+    }
+
+    printf("Drawing %d frames per zoom level and overlay at %dx%d\n", frames, width, height);
+    int result = 0;
+    for (int i = 0; i < num_saved_games; i++) {
+        if (!run_benchmark(names[i], saved_games[i], frames)) {
+            result = 3;
+        }
+    }
+    free(names);
+    free(saved_games);
+    software_renderer_shutdown();
+    return result;
+}
@@ -0,0 +1,716 @@
+#include "software_renderer.h"
+
+#include "core/config.h"
+#include "core/image.h"
+#include "graphics/renderer.h"
+#include "graphics/screen.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_UNPACKED_IMAGES 10
+#define MAX_PACKED_IMAGE_SIZE 64000
+#define MAX_IMAGE_SIZE 4096
+
+#define FOOTPRINT_WIDTH 58
+#define FOOTPRINT_HEIGHT 30
+
+typedef enum {
+    BLEND_NONE = 0,
+    BLEND_ALPHA = 1,
+    BLEND_MOD = 2
+} blend_mode;
+
+typedef struct {
+    int x_min;
+    int y_min;
+    int x_max;
+    int y_max;
+} bounds;
+
+typedef struct saved_image {
+    int id;
+    int width;
+    int height;
+    color_t *pixels;
+    struct saved_image *next;
+} saved_image;
+
+static struct {
+    color_t *pixels;
+    int width;
+    int height;
+    struct {
+        int x, y, width, height;
+    } viewport;
+    struct {
+        int active;
+        int x, y, width, height;
+    } clip;
+    image_atlas_data atlas_data[ATLAS_MAX];
+    int has_atlas[ATLAS_MAX];
+    struct {
+        color_t *buffer;
+        blend_mode blend;
+        image img;
+    } custom_images[CUSTOM_IMAGE_MAX];
+    struct {
+        int id;
+        color_t *pixels;
+        int width;
+    } unpacked_images[MAX_UNPACKED_IMAGES];
+    int next_unpacked_image;
+    struct {
+        saved_image *first;
+        int current_id;
+    } saved_images;
+    graphics_renderer_interface renderer_interface;
+    float city_scale;
+    int images_drawn;
+} data;
+
+static inline int multiply(int a, int b)
+{
+    int value = a * b + 128;
+    return (value + (value >> 8)) >> 8;
+}
+
+static inline color_t blend_pixel(color_t src, color_t dst)
+{
+    int alpha = (src & COLOR_CHANNEL_ALPHA) >> COLOR_BITSHIFT_ALPHA;
+    if (alpha == 0xff) {
+        return src;
+    }
+    if (!alpha) {
+        return dst;
+    }
+    int inverse = 0xff - alpha;
+    int a = alpha + multiply((dst & COLOR_CHANNEL_ALPHA) >> COLOR_BITSHIFT_ALPHA, inverse);
+    int r = multiply((src & COLOR_CHANNEL_RED) >> COLOR_BITSHIFT_RED, alpha) +
+        multiply((dst & COLOR_CHANNEL_RED) >> COLOR_BITSHIFT_RED, inverse);
+    int g = multiply((src & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN, alpha) +
+        multiply((dst & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN, inverse);
+    int b = multiply((src & COLOR_CHANNEL_BLUE) >> COLOR_BITSHIFT_BLUE, alpha) +
+        multiply((dst & COLOR_CHANNEL_BLUE) >> COLOR_BITSHIFT_BLUE, inverse);
+    return ((color_t) a << COLOR_BITSHIFT_ALPHA) | (r << COLOR_BITSHIFT_RED) |
+        (g << COLOR_BITSHIFT_GREEN) | (b << COLOR_BITSHIFT_BLUE);
+}
+
+static inline color_t modulate_pixel(color_t src, color_t dst)
+{
+    int r = multiply((src & COLOR_CHANNEL_RED) >> COLOR_BITSHIFT_RED, (dst & COLOR_CHANNEL_RED) >> COLOR_BITSHIFT_RED);
+    int g = multiply((src & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN,
+        (dst & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN);
+    int b = multiply((src & COLOR_CHANNEL_BLUE) >> COLOR_BITSHIFT_BLUE,
+        (dst & COLOR_CHANNEL_BLUE) >> COLOR_BITSHIFT_BLUE);
+    return (dst & COLOR_CHANNEL_ALPHA) | (r << COLOR_BITSHIFT_RED) | (g << COLOR_BITSHIFT_GREEN) |
+        (b << COLOR_BITSHIFT_BLUE);
+}
+
+static inline color_t apply_color(color_t pixel, color_t color)
+{
+    return ((color_t) multiply((pixel & COLOR_CHANNEL_ALPHA) >> COLOR_BITSHIFT_ALPHA,
+        (color & COLOR_CHANNEL_ALPHA) >> COLOR_BITSHIFT_ALPHA) << COLOR_BITSHIFT_ALPHA) |
+        (multiply((pixel & COLOR_CHANNEL_RED) >> COLOR_BITSHIFT_RED,
+        (color & COLOR_CHANNEL_RED) >> COLOR_BITSHIFT_RED) << COLOR_BITSHIFT_RED) |
+        (multiply((pixel & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN,
+        (color & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN) << COLOR_BITSHIFT_GREEN) |
+        (multiply((pixel & COLOR_CHANNEL_BLUE) >> COLOR_BITSHIFT_BLUE,
+        (color & COLOR_CHANNEL_BLUE) >> COLOR_BITSHIFT_BLUE) << COLOR_BITSHIFT_BLUE);
+}
+
+// The area that can be drawn to, in screen coordinates: the viewport, limited by the clip rectangle
+static bounds get_drawing_bounds(void)
+{
+    bounds b = { data.viewport.x, data.viewport.y,
+        data.viewport.x + data.viewport.width, data.viewport.y + data.viewport.height };
+    if (data.clip.active) {
+        int x = data.viewport.x + data.clip.x;
+        int y = data.viewport.y + data.clip.y;
+        if (x > b.x_min) {
+            b.x_min = x;
+        }
+        if (y > b.y_min) {
+            b.y_min = y;
+        }
+        if (x + data.clip.width < b.x_max) {
+            b.x_max = x + data.clip.width;
+        }
+        if (y + data.clip.height < b.y_max) {
+            b.y_max = y + data.clip.height;
+        }
+    }
+    if (b.x_min < 0) {
+        b.x_min = 0;
+    }
+    if (b.y_min < 0) {
+        b.y_min = 0;
+    }
+    if (b.x_max > data.width) {
+        b.x_max = data.width;
+    }
+    if (b.y_max > data.height) {
+        b.y_max = data.height;
+    }
+    return b;
+}
+
+static void put_pixel(const bounds *b, int x, int y, color_t color)
+{
+    x += data.viewport.x;
+    y += data.viewport.y;
+    if (x >= b->x_min && x < b->x_max && y >= b->y_min && y < b->y_max) {
+        color_t *pixel = &data.pixels[y * data.width + x];
+        *pixel = blend_pixel(color, *pixel);
+    }
+}
+
+// Copies a rectangle of pixels to another one, scaling it with the nearest pixel like the SDL renderer does
+static void blit(const color_t *src, int src_row_width, int src_x, int src_y, int src_width, int src_height,
+    color_t *dst, int dst_row_width, const bounds *clip, int dst_x, int dst_y, int dst_width, int dst_height,
+    color_t color, blend_mode blend)
+{
+    if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+        return;
+    }
+    int x_start = dst_x < clip->x_min ? clip->x_min : dst_x;
+    int y_start = dst_y < clip->y_min ? clip->y_min : dst_y;
+    int x_end = dst_x + dst_width > clip->x_max ? clip->x_max : dst_x + dst_width;
+    int y_end = dst_y + dst_height > clip->y_max ? clip->y_max : dst_y + dst_height;
+    if (x_start >= x_end || y_start >= y_end) {
+        return;
+    }
+    // source positions in 16.16 fixed point, sampled at the center of each destination pixel
+    int64_t x_step = ((int64_t) src_width << 16) / dst_width;
+    int64_t y_step = ((int64_t) src_height << 16) / dst_height;
+    int64_t x_first = (x_start - dst_x) * x_step + x_step / 2;
+    int has_color = color != COLOR_MASK_NONE;
+    for (int y = y_start; y < y_end; y++) {
+        int sy = src_y + (int) (((y - dst_y) * y_step + y_step / 2) >> 16);
+        const color_t *src_row = &src[sy * src_row_width + src_x];
+        color_t *dst_pixel = &dst[y * dst_row_width + x_start];
+        int64_t sx = x_first;
+        for (int x = x_start; x < x_end; x++, dst_pixel++, sx += x_step) {
+            color_t pixel = src_row[sx >> 16];
+            if (has_color) {
+                pixel = apply_color(pixel, color);
+            }
+            switch (blend) {
+                case BLEND_NONE:
+                    *dst_pixel = pixel;
+                    break;
+                case BLEND_MOD:
+                    *dst_pixel = modulate_pixel(pixel, *dst_pixel);
+                    break;
+                default:
+                    *dst_pixel = blend_pixel(pixel, *dst_pixel);
+                    break;
+            }
+        }
+    }
+}
+
+static void clear_screen(void)
+{
+    memset(data.pixels, 0, (size_t) data.width * data.height * sizeof(color_t));
+}
+
+static void set_viewport(int x, int y, int width, int height)
+{
+    data.viewport.x = x;
+    data.viewport.y = y;
+    data.viewport.width = width;
+    data.viewport.height = height;
+}
+
+static void reset_viewport(void)
+{
+    set_viewport(0, 0, data.width, data.height);
+    data.clip.active = 0;
+}
+
+static void set_clip_rectangle(int x, int y, int width, int height)
+{
+    data.clip.active = 1;
+    data.clip.x = x;
+    data.clip.y = y;
+    data.clip.width = width;
+    data.clip.height = height;
+}
+
+static void reset_clip_rectangle(void)
+{
+    data.clip.active = 0;
+}
+
+static void draw_line(int x_start, int x_end, int y_start, int y_end, color_t color)
+{
+    bounds b = get_drawing_bounds();
+    int dx = abs(x_end - x_start);
+    int dy = -abs(y_end - y_start);
+    int step_x = x_start < x_end ? 1 : -1;
+    int step_y = y_start < y_end ? 1 : -1;
+    int error = dx + dy;
+    int x = x_start;
+    int y = y_start;
+    while (1) {
+        put_pixel(&b, x, y, color);
+        if (x == x_end && y == y_end) {
+            break;
+        }
+        int error2 = 2 * error;
+        if (error2 >= dy) {
+            error += dy;
+            x += step_x;
+        }
+        if (error2 <= dx) {
+            error += dx;
+            y += step_y;
+        }
+    }
+}
+
+static void fill_rect(int x, int width, int y, int height, color_t color)
+{
+    bounds b = get_drawing_bounds();
+    blit(&color, 0, 0, 0, 1, 1, data.pixels, data.width, &b,
+        data.viewport.x + x, data.viewport.y + y, width, height, COLOR_MASK_NONE, BLEND_ALPHA);
+}
+
+static void draw_rect(int x, int width, int y, int height, color_t color)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    fill_rect(x, width, y, 1, color);
+    if (height > 1) {
+        fill_rect(x, width, y + height - 1, 1, color);
+    }
+    if (height > 2) {
+        fill_rect(x, 1, y + 1, height - 2, color);
+        if (width > 1) {
+            fill_rect(x + width - 1, 1, y + 1, height - 2, color);
+        }
+    }
+}
+
+static const color_t *get_image_pixels(int atlas_id, int *row_width)
+{
+    atlas_type type = atlas_id >> IMAGE_ATLAS_BIT_OFFSET;
+    int index = atlas_id & IMAGE_ATLAS_BIT_MASK;
+    if (type == ATLAS_CUSTOM || type == ATLAS_EXTERNAL) {
+        if (type == ATLAS_EXTERNAL) {
+            index = CUSTOM_IMAGE_EXTERNAL;
+        }
+        if (index >= CUSTOM_IMAGE_MAX) {
+            return 0;
+        }
+        *row_width = data.custom_images[index].img.width;
+        return data.custom_images[index].buffer;
+    } else if (type == ATLAS_UNPACKED_EXTRA_ASSET) {
+        for (int i = 0; i < MAX_UNPACKED_IMAGES; i++) {
+            if (data.unpacked_images[i].pixels && data.unpacked_images[i].id == index) {
+                *row_width = data.unpacked_images[i].width;
+                return data.unpacked_images[i].pixels;
+            }
+        }
+        return 0;
+    }
+    if (type >= ATLAS_MAX || !data.has_atlas[type] || index >= data.atlas_data[type].num_images) {
+        return 0;
+    }
+    *row_width = data.atlas_data[type].image_widths[index];
+    return data.atlas_data[type].buffers[index];
+}
+
+static void draw_image_with_blend(const image *img, int x, int y, color_t color, float scale, blend_mode blend)
+{
+    if (!color) {
+        color = COLOR_MASK_NONE;
+    }
+    int row_width;
+    const color_t *pixels = get_image_pixels(img->atlas.id, &row_width);
+    if (!pixels) {
+        return;
+    }
+    data.images_drawn++;
+
+    x += img->x_offset;
+    y += img->y_offset;
+
+    // Same as the SDL renderer: when zooming out, isometric images are made smaller to show the grid
+    int grid_correction = (img->is_isometric && config_get(CONFIG_UI_SHOW_GRID) && data.city_scale > 2.0f) ? 2 : 0;
+
+    bounds b = get_drawing_bounds();
+    blit(pixels, row_width, img->atlas.x_offset, img->atlas.y_offset, img->width, img->height,
+        data.pixels, data.width, &b,
+        data.viewport.x + (int) round((x + grid_correction) / scale),
+        data.viewport.y + (int) round((y + grid_correction) / scale),
+        (int) round((img->width - grid_correction) / scale), (int) round((img->height - grid_correction) / scale),
+        color, blend);
+}
+
+static void draw_image(const image *img, int x, int y, color_t color, float scale)
+{
+    draw_image_with_blend(img, x, y, color, scale, BLEND_ALPHA);
+}
+
+static void free_custom_image(custom_image_type type)
+{
+    free(data.custom_images[type].buffer);
+    data.custom_images[type].buffer = 0;
+    memset(&data.custom_images[type].img, 0, sizeof(image));
+}
+
+static int init_custom_image(custom_image_type type, int width, int height, blend_mode blend)
+{
+    free_custom_image(type);
+    data.custom_images[type].buffer = calloc((size_t) width * height, sizeof(color_t));
+    if (!data.custom_images[type].buffer) {
+        return 0;
+    }
+    data.custom_images[type].blend = blend;
+    data.custom_images[type].img.width = width;
+    data.custom_images[type].img.height = height;
+    data.custom_images[type].img.atlas.id = (ATLAS_CUSTOM << IMAGE_ATLAS_BIT_OFFSET) | type;
+    return 1;
+}
+
+static void create_custom_image(custom_image_type type, int width, int height, int is_yuv)
+{
+    init_custom_image(type, width, height, type == CUSTOM_IMAGE_VIDEO ? BLEND_NONE : BLEND_ALPHA);
+}
+
+static int has_custom_image(custom_image_type type)
+{
+    return data.custom_images[type].buffer != 0;
+}
+
+static color_t *get_custom_image_buffer(custom_image_type type, int *actual_texture_width)
+{
+    if (actual_texture_width) {
+        *actual_texture_width = data.custom_images[type].img.width;
+    }
+    return data.custom_images[type].buffer;
+}
+
+static void release_custom_image_buffer(custom_image_type type)
+{
+    // the buffer is the image itself
+}
+
+static void update_custom_image(custom_image_type type)
+{
+}
+
+static void update_custom_image_yuv(custom_image_type type, const uint8_t *y_data, int y_width,
+    const uint8_t *cb_data, int cb_width, const uint8_t *cr_data, int cr_width)
+{
+}
+
+static int supports_yuv_image_format(void)
+{
+    return 0;
+}
+
+static void create_footprint_image(custom_image_type type)
+{
+    if (!init_custom_image(type, FOOTPRINT_WIDTH, FOOTPRINT_HEIGHT, BLEND_MOD)) {
+        return;
+    }
+    color_t *buffer = data.custom_images[type].buffer;
+    for (int i = 0; i < FOOTPRINT_WIDTH * FOOTPRINT_HEIGHT; i++) {
+        buffer[i] = COLOR_WHITE;
+    }
+    data.custom_images[type].img.is_isometric = 1;
+
+    const image *flat_tile = image_get(image_group(GROUP_TERRAIN_FLAT_TILE));
+    int row_width;
+    const color_t *pixels = get_image_pixels(flat_tile->atlas.id, &row_width);
+    if (!pixels) {
+        return;
+    }
+    bounds b = { 0, 0, FOOTPRINT_WIDTH, FOOTPRINT_HEIGHT };
+    blit(pixels, row_width, flat_tile->atlas.x_offset, flat_tile->atlas.y_offset, flat_tile->width, flat_tile->height,
+        buffer, FOOTPRINT_WIDTH, &b, 0, 0, FOOTPRINT_WIDTH, FOOTPRINT_HEIGHT,
+        type == CUSTOM_IMAGE_RED_FOOTPRINT ? COLOR_MASK_RED : COLOR_MASK_GREEN, BLEND_ALPHA);
+}
+
+static void draw_custom_image(custom_image_type type, int x, int y, float scale, int disable_filtering)
+{
+    if ((type == CUSTOM_IMAGE_RED_FOOTPRINT || type == CUSTOM_IMAGE_GREEN_FOOTPRINT) &&
+        !data.custom_images[type].buffer) {
+        create_footprint_image(type);
+    }
+    draw_image_with_blend(&data.custom_images[type].img, x, y, 0, scale, data.custom_images[type].blend);
+}
+
+static saved_image *get_saved_image(int image_id)
+{
+    for (saved_image *saved = data.saved_images.first; saved; saved = saved->next) {
+        if (saved->id == image_id) {
+            return saved;
+        }
+    }
+    return 0;
+}
+
+static int save_screen_buffer(color_t *pixels, int x, int y, int width, int height, int row_width)
+{
+    x += data.viewport.x;
+    y += data.viewport.y;
+    if (x < 0 || y < 0 || x + width > data.width || y + height > data.height) {
+        return 0;
+    }
+    for (int row = 0; row < height; row++) {
+        memcpy(&pixels[row * row_width], &data.pixels[(y + row) * data.width + x], width * sizeof(color_t));
+    }
+    return 1;
+}
+
+static int save_image_from_screen(int image_id, int x, int y, int width, int height)
+{
+    saved_image *saved = get_saved_image(image_id);
+    if (!saved) {
+        saved = calloc(1, sizeof(saved_image));
+        if (!saved) {
+            return 0;
+        }
+        saved->id = ++data.saved_images.current_id;
+        saved->next = data.saved_images.first;
+        data.saved_images.first = saved;
+    }
+    if (saved->width * saved->height < width * height) {
+        free(saved->pixels);
+        saved->pixels = malloc((size_t) width * height * sizeof(color_t));
+    }
+    if (!saved->pixels) {
+        saved->width = 0;
+        saved->height = 0;
+        return 0;
+    }
+    saved->width = width;
+    saved->height = height;
+    if (!save_screen_buffer(saved->pixels, x, y, width, height, width)) {
+        return 0;
+    }
+    return saved->id;
+}
+
+static void draw_image_to_screen(int image_id, int x, int y)
+{
+    saved_image *saved = get_saved_image(image_id);
+    if (!saved || !saved->pixels) {
+        return;
+    }
+    bounds b = get_drawing_bounds();
+    blit(saved->pixels, saved->width, 0, 0, saved->width, saved->height, data.pixels, data.width, &b,
+        data.viewport.x + x, data.viewport.y + y, saved->width, saved->height, COLOR_MASK_NONE, BLEND_ALPHA);
+}
+
+static void get_max_image_size(int *width, int *height)
+{
+    *width = MAX_IMAGE_SIZE;
+    *height = MAX_IMAGE_SIZE;
+}
+
+static void free_unpacked_images(void)
+{
+    for (int i = 0; i < MAX_UNPACKED_IMAGES; i++) {
+        free(data.unpacked_images[i].pixels);
+    }
+    memset(data.unpacked_images, 0, sizeof(data.unpacked_images));
+    data.next_unpacked_image = 0;
+}
+
+static void free_image_atlas(atlas_type type)
+{
+    image_atlas_data *atlas_data = &data.atlas_data[type];
+    if (atlas_data->buffers) {
+        for (int i = 0; i < atlas_data->num_images; i++) {
+            free(atlas_data->buffers[i]);
+        }
+    }
+    free(atlas_data->buffers);
+    free(atlas_data->image_widths);
+    free(atlas_data->image_heights);
+    memset(atlas_data, 0, sizeof(image_atlas_data));
+    atlas_data->type = type;
+    data.has_atlas[type] = 0;
+    if (type == ATLAS_EXTRA_ASSET) {
+        free_unpacked_images();
+    }
+}
+
+static const image_atlas_data *prepare_image_atlas(atlas_type type, int num_images, int last_width, int last_height)
+{
+    free_image_atlas(type);
+    image_atlas_data *atlas_data = &data.atlas_data[type];
+    atlas_data->num_images = num_images;
+    atlas_data->image_widths = malloc(sizeof(int) * num_images);
+    atlas_data->image_heights = malloc(sizeof(int) * num_images);
+    atlas_data->buffers = calloc(num_images, sizeof(color_t *));
+    if (!atlas_data->image_widths || !atlas_data->image_heights || !atlas_data->buffers) {
+        free_image_atlas(type);
+        return 0;
+    }
+    for (int i = 0; i < num_images; i++) {
+        atlas_data->image_widths[i] = i == num_images - 1 ? last_width : MAX_IMAGE_SIZE;
+        atlas_data->image_heights[i] = i == num_images - 1 ? last_height : MAX_IMAGE_SIZE;
+        atlas_data->buffers[i] = calloc((size_t) atlas_data->image_widths[i] * atlas_data->image_heights[i],
+            sizeof(color_t));
+        if (!atlas_data->buffers[i]) {
+            free_image_atlas(type);
+            return 0;
+        }
+    }
+    return atlas_data;
+}
+
+static int create_image_atlas(const image_atlas_data *atlas_data, int delete_buffers)
+{
+    if (!atlas_data || atlas_data != &data.atlas_data[atlas_data->type] || !atlas_data->num_images) {
+        return 0;
+    }
+    // the buffers are what gets drawn, so they are kept even when the caller does not need them anymore
+    data.has_atlas[atlas_data->type] = 1;
+    return 1;
+}
+
+static const image_atlas_data *get_image_atlas(atlas_type type)
+{
+    return data.has_atlas[type] ? &data.atlas_data[type] : 0;
+}
+
+static int has_image_atlas(atlas_type type)
+{
+    return data.has_atlas[type];
+}
+
+static void load_unpacked_image(const image *img, const color_t *pixels)
+{
+    int unpacked_image_id = img->atlas.id & IMAGE_ATLAS_BIT_MASK;
+    for (int i = 0; i < MAX_UNPACKED_IMAGES; i++) {
+        if (data.unpacked_images[i].pixels && data.unpacked_images[i].id == unpacked_image_id) {
+            return;
+        }
+    }
+    int height = img->height;
+    if (img->top) {
+        height += img->top->height;
+    }
+    size_t size = (size_t) img->width * height * sizeof(color_t);
+    color_t *copy = malloc(size);
+    if (!copy) {
+        return;
+    }
+    memcpy(copy, pixels, size);
+    int index = data.next_unpacked_image;
+    data.next_unpacked_image = (index + 1) % MAX_UNPACKED_IMAGES;
+    free(data.unpacked_images[index].pixels);
+    data.unpacked_images[index].id = unpacked_image_id;
+    data.unpacked_images[index].pixels = copy;
+    data.unpacked_images[index].width = img->width;
+}
+
+static int should_pack_image(int width, int height)
+{
+    return width * height < MAX_PACKED_IMAGE_SIZE;
+}
+
+static void update_scale(int city_scale)
+{
+    data.city_scale = city_scale / 100.0f;
+}
+
+static void create_renderer_interface(void)
+{
+    data.renderer_interface.clear_screen = clear_screen;
+    data.renderer_interface.set_viewport = set_viewport;
+    data.renderer_interface.reset_viewport = reset_viewport;
+    data.renderer_interface.set_clip_rectangle = set_clip_rectangle;
+    data.renderer_interface.reset_clip_rectangle = reset_clip_rectangle;
+    data.renderer_interface.draw_line = draw_line;
+    data.renderer_interface.draw_rect = draw_rect;
+    data.renderer_interface.fill_rect = fill_rect;
+    data.renderer_interface.draw_image = draw_image;
+    data.renderer_interface.create_custom_image = create_custom_image;
+    data.renderer_interface.has_custom_image = has_custom_image;
+    data.renderer_interface.get_custom_image_buffer = get_custom_image_buffer;
+    data.renderer_interface.release_custom_image_buffer = release_custom_image_buffer;
+    data.renderer_interface.update_custom_image = update_custom_image;
+    data.renderer_interface.update_custom_image_yuv = update_custom_image_yuv;
+    data.renderer_interface.draw_custom_image = draw_custom_image;
+    data.renderer_interface.supports_yuv_image_format = supports_yuv_image_format;
+    data.renderer_interface.save_image_from_screen = save_image_from_screen;
+    data.renderer_interface.draw_image_to_screen = draw_image_to_screen;
+    data.renderer_interface.save_screen_buffer = save_screen_buffer;
+    data.renderer_interface.get_max_image_size = get_max_image_size;
+    data.renderer_interface.prepare_image_atlas = prepare_image_atlas;
+    data.renderer_interface.create_image_atlas = create_image_atlas;
+    data.renderer_interface.get_image_atlas = get_image_atlas;
+    data.renderer_interface.has_image_atlas = has_image_atlas;
+    data.renderer_interface.free_image_atlas = free_image_atlas;
+    data.renderer_interface.load_unpacked_image = load_unpacked_image;
+    data.renderer_interface.should_pack_image = should_pack_image;
+    data.renderer_interface.update_scale = update_scale;
+
+    graphics_renderer_set_interface(&data.renderer_interface);
+}
+
+int software_renderer_init(int width, int height)
+{
+    software_renderer_shutdown();
+    data.pixels = calloc((size_t) width * height, sizeof(color_t));
+    if (!data.pixels) {
+        return 0;
+    }
+    data.width = width;
+    data.height = height;
+    data.city_scale = 1.0f;
+    for (atlas_type type = ATLAS_FIRST; type < ATLAS_MAX; type++) {
+        data.atlas_data[type].type = type;
+    }
+    reset_viewport();
+    create_renderer_interface();
+    return 1;
+}
+
+void software_renderer_shutdown(void)
+{
+    for (atlas_type type = ATLAS_FIRST; type < ATLAS_MAX; type++) {
+        free_image_atlas(type);
+    }
+    for (int i = 0; i < CUSTOM_IMAGE_MAX; i++) {
+        free_custom_image(i);
+    }
+    saved_image *saved = data.saved_images.first;
+    while (saved) {
+        saved_image *next = saved->next;
+        free(saved->pixels);
+        free(saved);
+        saved = next;
+    }
+    data.saved_images.first = 0;
+    data.saved_images.current_id = 0;
+    free(data.pixels);
+    data.pixels = 0;
+    data.width = 0;
+    data.height = 0;
+}
+
+const color_t *software_renderer_get_pixels(void)
+{
+    return data.pixels;
+}
+
+int software_renderer_get_images_drawn(void)
+{
+    return data.images_drawn;
+}
+
+void software_renderer_reset_images_drawn(void)
+{
+    data.images_drawn = 0;
+}
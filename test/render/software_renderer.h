@@ -0,0 +1,36 @@
+#ifndef TEST_RENDER_SOFTWARE_RENDERER_H
+#define TEST_RENDER_SOFTWARE_RENDERER_H
+
+#include "graphics/color.h"
+
+/**
+ * Sets up a renderer that draws into a framebuffer in memory and makes it the current renderer
+ * @param width Width of the framebuffer
+ * @param height Height of the framebuffer
+ * @return 1 if the framebuffer could be created, 0 otherwise
+ */
+int software_renderer_init(int width, int height);
+
+/**
+ * Frees the framebuffer and all images
+ */
+void software_renderer_shutdown(void);
+
+/**
+ * Gets the pixels of the framebuffer
+ * @return The pixels, one row of screen_width() pixels after the other
+ */
+const color_t *software_renderer_get_pixels(void);
+
+/**
+ * Gets the number of images drawn since the last reset
+ * @return The number of images drawn
+ */
+int software_renderer_get_images_drawn(void);
+
+/**
+ * Resets the count of images drawn
+ */
+void software_renderer_reset_images_drawn(void);
+
+#endif // TEST_RENDER_SOFTWARE_RENDERER_H
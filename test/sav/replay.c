@@ -0,0 +1,79 @@
+#include "core/time.h"
+#include "game/file.h"
+#include "game/file_io.h"
+#include "game/game.h"
+#include "game/replay.h"
+#include "game/time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double elapsed_millis(clock_t start)
+{
+    return (clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+static int run_replay(const char *saved_game, const char *commands, int months_after_commands,
+    const char *expected_hash)
+{
+    printf("Replaying: %s with commands %s\n", saved_game, commands);
+
+    if (!game_pre_init()) {
+        printf("Unable to run Game_preInit\n");
+        return 1;
+    }
+    if (!game_init()) {
+        printf("Unable to run Game_init\n");
+        return 2;
+    }
+    if (!game_file_load_saved_game(saved_game)) {
+        printf("Unable to load saved game %s\n", saved_game);
+        return 3;
+    }
+    int num_commands = game_replay_load(commands);
+    if (num_commands < 0) {
+        printf("Unable to load commands %s\n", commands);
+        return 4;
+    }
+    printf("Loaded %d commands\n", num_commands);
+    printf("year month hash millis\n");
+
+    time_set_millis(0);
+    int month = game_time_month();
+    int has_commands = 1;
+    clock_t total = clock();
+    clock_t month_start = total;
+    uint32_t hash = 0;
+    while (has_commands || months_after_commands > 0) {
+        has_commands = game_replay_run_tick();
+        if (game_time_month() != month) {
+            double millis = elapsed_millis(month_start);
+            hash = game_file_io_saved_game_hash();
+            printf("%d %d %08x %.1f\n", game_time_year(), month, hash, millis);
+            month = game_time_month();
+            if (!has_commands) {
+                months_after_commands--;
+            }
+            month_start = clock();
+        }
+    }
+    printf("Total: %.1f ms\n", elapsed_millis(total));
+
+    game_exit();
+    if (expected_hash && hash != (uint32_t) strtoul(expected_hash, 0, 16)) {
+        printf("The game state of the last month differs from the expected one: %s\n", expected_hash);
+        return 5;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3 || argc > 5) {
+        printf("Usage: replay <saved game> <commands> [months to run after the last command] [expected hash]\n");
+        return -1;
+    }
+    int months = argc >= 4 ? atoi(argv[3]) : 1;
+    return run_replay(argv[1], argv[2], months, argc == 5 ? argv[4] : 0);
+}
@@ -1,6 +1,6 @@
-#include "core/backtrace.h"
 #include "core/time.h"
 #include "game/file.h"
+#include "game/file_io.h"
 #include "game/game.h"
 #include "game/settings.h"
 
@@ -15,12 +15,10 @@
 #include <signal.h>
 #include <stdlib.h>
 #include <stdio.h>
-#include "sav_compare.h"
 
 static void handler(int sig)
 {
     fprintf(stderr, "Oops, crashed with signal %d :(", sig);
-    backtrace_print();
     exit(1);
 }
 
@@ -34,7 +32,19 @@ static void run_ticks(int ticks)
     }
 }
 
-static int run_autopilot(const char *input_saved_game, const char *output_saved_game, int ticks_to_run)
+// Hashes the game state of a saved game as it is loaded, so saved games of any version can be compared
+static int saved_game_hash(const char *saved_game, uint32_t *hash)
+{
+    if (game_file_load_saved_game(saved_game) != 1) {
+        printf("Unable to load saved game %s\n", saved_game);
+        return 0;
+    }
+    *hash = game_file_io_saved_game_hash();
+    return 1;
+}
+
+static int run_autopilot(const char *input_saved_game, const char *output_saved_game, int ticks_to_run,
+    const char *expected_saved_game, uint32_t *hash, uint32_t *expected_hash)
 {
     printf("Running autopilot: %s --> %s in %d ticks\n", input_saved_game, output_saved_game, ticks_to_run);
     signal(SIGSEGV, handler);
@@ -61,6 +71,9 @@ static int run_autopilot(const char *input_saved_game, const char *output_saved_
     run_ticks(ticks_to_run);
     printf("Saving game to %s\n", output_saved_game);
     game_file_write_saved_game(output_saved_game);
+    if (!saved_game_hash(output_saved_game, hash) || !saved_game_hash(expected_saved_game, expected_hash)) {
+        return 4;
+    }
     printf("Done\n");
 
     game_exit();
@@ -68,6 +81,11 @@ static int run_autopilot(const char *input_saved_game, const char *output_saved_
     return 0;
 }
 
+/**
+ * Usage: autopilot INPUT_SAVED_GAME OUTPUT_SAVED_GAME EXPECTED_SAVED_GAME TICKS
+ * Both the output and the expected saved game are loaded before their game states are compared,
+ * so the expected saved game may have been written with an older saved game layout.
+ */
 int main(int argc, char **argv)
 {
     if (argc != 5) {
@@ -78,9 +96,15 @@ int main(int argc, char **argv)
     const char *output = argv[2];
     const char *expected = argv[3];
     int ticks = atoi(argv[4]);
-    if (run_autopilot(input, output, ticks) == 0) {
-        return compare_files(expected, output);
-    } else {
+    uint32_t hash;
+    uint32_t expected_hash;
+    if (run_autopilot(input, output, ticks, expected, &hash, &expected_hash) != 0) {
+        return 1;
+    }
+    printf("Game state hash: %08x, expected %08x\n", hash, expected_hash);
+    if (hash != expected_hash) {
+        printf("The game state differs from the one in %s\n", expected);
         return 1;
     }
+    return 0;
 }
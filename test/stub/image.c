@@ -1,3 +1,6 @@
+#include "assets/assets.h"
+#include "assets/group.h"
+#include "assets/image.h"
 #include "core/image.h"
 
 static int groups[] = {
@@ -33,12 +36,15 @@ static int groups[] = {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
+// Drawing code expects every image to exist: an empty image draws nothing
+static const image BLANK_IMAGE;
+
 int image_init(void)
 {
     return 1;
 }
 
-int image_load_climate(int climate_id, int is_editor, int force_reload)
+int image_load_climate(int climate_id, int is_editor, int force_reload, int keep_atlas_buffers)
 {
     return 1;
 }
@@ -59,6 +65,57 @@ int image_group(int group)
 }
 
 const image *image_get(int id)
+{
+    return &BLANK_IMAGE;
+}
+
+const image *image_letter(int letter_id)
+{
+    return &BLANK_IMAGE;
+}
+
+const image *image_get_enemy(int id)
+{
+    return &BLANK_IMAGE;
+}
+
+int image_is_external(const image *img)
+{
+    return 0;
+}
+
+void image_load_external_data(const image *img)
+{}
+
+int assets_get_group_id(const char *assetlist_name)
+{
+    return 0;
+}
+
+int assets_get_image_id(const char *assetlist_name, const char *image_name)
+{
+    return 0;
+}
+
+const image *assets_get_image(int image_id)
+{
+    return 0;
+}
+
+int assets_load_single_group(const char *file_name, color_t **main_images, int *main_image_widths)
+{
+    return 0;
+}
+
+void assets_load_unpacked_asset(int image_id)
+{}
+
+image_groups *group_get_current(void)
+{
+    return 0;
+}
+
+asset_image *asset_image_get_from_id(int image_id)
 {
     return 0;
 }
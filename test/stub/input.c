@@ -1,3 +1,4 @@
+#include "game/system.h"
 #include "input/hotkey.h"
 #include "input/keys.h"
 #include "input/mouse.h"
@@ -22,6 +23,11 @@ key_type system_keyboard_key_for_symbol(const char *name)
     return KEY_TYPE_NONE;
 }
 
+time_millis system_get_millis(void)
+{
+    return 0;
+}
+
 void mouse_reset_up_state(void)
 {
 }
@@ -1,5 +1,4 @@
 #include "core/lang.h"
-#include "core/encoding.h"
 
 static uint8_t EMPTY[] = {0};
 
@@ -10,6 +9,11 @@ int lang_load(int is_editor)
     return 1;
 }
 
+int lang_dir_is_valid(const char *dir)
+{
+    return 1;
+}
+
 const uint8_t *lang_get_string(int group, int index)
 {
     return EMPTY;
@@ -21,8 +25,5 @@ const lang_message *lang_get_message(int id)
     return &msg;
 }
 
-void font_set_encoding(encoding_type encoding)
-{}
-
-void translation_load(language_type language)
+void load_custom_messages(void)
 {}
@@ -169,3 +169,20 @@ const model_house *model_get_house(house_level level)
 {
     return &houses[level];
 }
+
+int model_house_uses_inventory(house_level level, inventory_type inventory)
+{
+    const model_house *house = model_get_house(level);
+    switch (inventory) {
+        case INVENTORY_WINE:
+            return house->wine;
+        case INVENTORY_OIL:
+            return house->oil;
+        case INVENTORY_FURNITURE:
+            return house->furniture;
+        case INVENTORY_POTTERY:
+            return house->pottery;
+        default:
+            return 0;
+    }
+}
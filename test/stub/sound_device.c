@@ -9,6 +9,9 @@ void sound_device_close(void)
 void sound_device_init_channels(int num_channels, char filenames[][CHANNEL_FILENAME_MAX])
 {}
 
+void sound_device_preload_channels(int first_channel, int last_channel)
+{}
+
 int sound_device_is_channel_playing(int channel)
 {
     return 0;
@@ -39,3 +42,12 @@ void sound_device_stop_music(void)
 
 void sound_device_stop_channel(int channel)
 {}
+
+void sound_device_use_custom_music_player(int bitdepth, int num_channels, int rate, const void *audio_data, int len)
+{}
+
+void sound_device_write_custom_music_data(const void *audio_data, int len)
+{}
+
+void sound_device_use_default_music_player(void)
+{}
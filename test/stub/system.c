@@ -0,0 +1,158 @@
+#include "game/system.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+const char *system_version(void)
+{
+    return "renderbench";
+}
+
+void system_resize(int width, int height)
+{
+}
+
+void system_get_max_resolution(int *width, int *height)
+{
+    *width = 1920;
+    *height = 1080;
+}
+
+void system_center(void)
+{
+}
+
+int system_is_fullscreen_only(void)
+{
+    return 0;
+}
+
+void system_set_fullscreen(int fullscreen)
+{
+}
+
+int system_scale_display(int scale_percentage)
+{
+    return 100;
+}
+
+int system_get_max_display_scale(void)
+{
+    return 100;
+}
+
+void system_init_cursors(int scale_percentage)
+{
+}
+
+void system_set_cursor(int cursor_id)
+{
+}
+
+void system_show_cursor(void)
+{
+}
+
+void system_hide_cursor(void)
+{
+}
+
+key_type system_keyboard_key_for_symbol(const char *name)
+{
+    return KEY_TYPE_NONE;
+}
+
+const char *system_keyboard_key_name(key_type key)
+{
+    return "";
+}
+
+const char *system_keyboard_key_modifier_name(key_modifier_type modifier)
+{
+    return "";
+}
+
+void system_keyboard_set_input_rect(int x, int y, int width, int height)
+{
+}
+
+void system_keyboard_show(void)
+{
+}
+
+void system_keyboard_hide(void)
+{
+}
+
+void system_start_text_input(void)
+{
+}
+
+void system_stop_text_input(void)
+{
+}
+
+void system_mouse_set_relative_mode(int enabled)
+{
+}
+
+void system_mouse_get_relative_state(int *x, int *y)
+{
+    *x = 0;
+    *y = 0;
+}
+
+void system_move_mouse_cursor(int delta_x, int delta_y)
+{
+}
+
+void system_set_mouse_position(int *x, int *y)
+{
+}
+
+void system_setup_crash_handler(void)
+{
+}
+
+void system_exit(void)
+{
+    exit(0);
+}
+
+// Without threads, the callers do their work on the main thread
+system_thread *system_thread_run(int (*function)(void *), void *data)
+{
+    return 0;
+}
+
+int system_thread_wait(system_thread *thread)
+{
+    return 0;
+}
+
+system_semaphore *system_semaphore_create(int value)
+{
+    return 0;
+}
+
+void system_semaphore_destroy(system_semaphore *semaphore)
+{
+}
+
+void system_semaphore_wait(system_semaphore *semaphore)
+{
+}
+
+int system_semaphore_try_wait(system_semaphore *semaphore)
+{
+    return 0;
+}
+
+void system_semaphore_post(system_semaphore *semaphore)
+{
+}
+
+time_millis system_get_millis(void)
+{
+    return (time_millis) (clock() * 1000 / CLOCKS_PER_SEC);
+}
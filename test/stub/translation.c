@@ -0,0 +1,15 @@
+#include "core/encoding.h"
+#include "translation/translation.h"
+
+static uint8_t EMPTY[] = {0};
+
+void font_set_encoding(encoding_type encoding)
+{}
+
+void translation_load(language_type language)
+{}
+
+uint8_t *translation_for(translation_key key)
+{
+    return EMPTY;
+}
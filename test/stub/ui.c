@@ -1,4 +1,8 @@
+#include "graphics/renderer.h"
+#include "graphics/text.h"
 #include "graphics/window.h"
+#include "widget/city_with_overlay.h"
+#include "widget/minimap.h"
 #include "window/message_dialog.h"
 #include "window/popup_dialog.h"
 #include "window/mission_end.h"
@@ -55,12 +59,41 @@ void window_message_dialog_show_city_message(int text_id, int year, int month,
                                              int param1, int param2, int message_advisor, int use_popup)
 {}
 
-void window_popup_dialog_show(popup_dialog_type type, void (*okFunc)(int), int hasOkCancelButtons)
+void window_popup_dialog_show(popup_dialog_type type,
+        void (*close_func)(int accepted, int checked), int has_ok_cancel_buttons)
+{}
+
+void window_popup_dialog_show_confirmation(const uint8_t *custom_title, const uint8_t *custom_text,
+    const uint8_t *checkbox_text, void (*close_func)(int accepted, int checked))
+{}
+
+void city_with_overlay_reset_cache(void)
 {}
 
 void widget_minimap_invalidate(void)
 {}
 
+void widget_minimap_update(const minimap_functions *functions)
+{}
+
+void widget_minimap_store_tile_types(const minimap_functions *functions, uint8_t *tile_types)
+{}
+
+void text_clear_cache(void)
+{}
+
+static void update_scale(int scale)
+{}
+
+static const graphics_renderer_interface renderer = {
+    .update_scale = update_scale
+};
+
+const graphics_renderer_interface *graphics_renderer(void)
+{
+    return &renderer;
+}
+
 int window_building_info_get_building_type(void)
 {
     return 0;